@@ -0,0 +1,148 @@
+/**
+ * @file affinity.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Affinity module. Pins the calling thread to one of the processors
+ * the process is allowed to run on, optionally to the processors of one NUMA node first.
+ *
+ **/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <sched.h>
+#include <dirent.h>
+
+#include "affinity.h"
+
+// processors the process was allowed to run on when it saved them, saved is 0 before,
+// child processes inherit both, so they pin themselves within the saved processors even
+// if their parent pinned itself to one processor before it started them
+static cpu_set_t original;
+static int saved = 0;
+
+/**
+ * reads the processors the calling thread may run on
+ * @brief the saved processors are taken if the process saved them
+ * @param *allowed - the processors are written to it
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int readAllowed(cpu_set_t *allowed) {
+    if (saved) {
+        *allowed = original;
+        return 1;
+    }
+    return sched_getaffinity(0, sizeof(*allowed), allowed) == -1 ? -1 : 1;
+}
+
+/**
+ * saves the processors the process may run on
+ * @brief called once before the process pins itself, not thread safe
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int saveAllowedCpus(void) {
+    if (sched_getaffinity(0, sizeof(original), &original) == -1) {
+        return -1;
+    }
+    saved = 1;
+    return 1;
+}
+
+/**
+ * returns the NUMA node of a processor
+ * @brief the node is read from the nodeN entry of the processor in sysfs
+ * @param cpu - the processor
+ * @return the node, integer -1 if unknown
+ **/
+int cpuNode(int cpu) {
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+
+    DIR *dir = opendir(path);
+    if (dir == NULL) {
+        return -1;
+    }
+
+    int node = -1;
+    struct dirent *entry;
+    while (node == -1 && (entry = readdir(dir)) != NULL) {
+        char *end;
+        if (strncmp(entry->d_name, "node", 4) == 0 && isdigit((unsigned char) entry->d_name[4])) {
+            long value = strtol(entry->d_name + 4, &end, 10);
+            if (*end == '\0') {
+                node = value;
+            }
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+/**
+ * returns the number of processors the calling thread may run on
+ * @return number of allowed processors, integer -1 if failure
+ **/
+int allowedCpus(void) {
+    cpu_set_t allowed;
+    if (readAllowed(&allowed) == -1) {
+        return -1;
+    }
+    return CPU_COUNT(&allowed);
+}
+
+/**
+ * pins the calling thread to a processor, preferring a node
+ * @brief the index counts the allowed processors of the process, the saved ones if it
+ * saved them, the processors of the node come first. It wraps around if there are less
+ * processors than indices.
+ * @param index - index of the processor among the allowed processors
+ * @param node - the preferred NUMA node, -1 for the order of the processor numbers
+ * @return the pinned processor, integer -1 if failure
+ **/
+int pinToCpuNear(int index, int node) {
+    cpu_set_t allowed;
+    if (readAllowed(&allowed) == -1) {
+        return -1;
+    }
+
+    int count = CPU_COUNT(&allowed);
+    if (count == 0) {
+        return -1;
+    }
+
+    // first round the processors of the node, second round the others
+    int wanted = index % count;
+    for (int round = node == -1 ? 1 : 0; round < 2; round++) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (!CPU_ISSET(cpu, &allowed) || (node != -1 && (cpuNode(cpu) == node) != (round == 0))) {
+                continue;
+            }
+
+            if (wanted-- == 0) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                if (sched_setaffinity(0, sizeof(set), &set) == -1) {
+                    return -1;
+                }
+                return cpu;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * pins the calling thread to a processor
+ * @brief the index counts the allowed processors of the process, it wraps around
+ * if there are less processors than indices
+ * @param index - index of the processor among the allowed processors
+ * @return the pinned processor, integer -1 if failure
+ **/
+int pinToCpu(int index) {
+    return pinToCpuNear(index, -1);
+}
@@ -0,0 +1,19 @@
+/**
+ * @file affinity.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Contains definitions for affinity.c
+ *
+ **/
+
+#ifndef AFFINITY_H
+#define AFFINITY_H
+
+int cpuNode(int cpu);
+int saveAllowedCpus(void);
+int allowedCpus(void);
+int pinToCpuNear(int index, int node);
+int pinToCpu(int index);
+
+#endif
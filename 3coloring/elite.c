@@ -0,0 +1,237 @@
+/**
+ * @file elite.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Elite module. A second shared memory object holds a few good colorings of every
+ * part of the graph. Local search generators migrate their colorings into it and restart
+ * from one of them instead of a random coloring, so good partial work is shared between
+ * the generators. Every entry is a sequence lock: writers take an entry with one compare
+ * and swap of its version and give up if another generator holds it, readers copy the
+ * entry and retry if the version changed. Nobody ever waits for another generator. An entry
+ * whose writer died while writing it stays odd, the next writer takes it over once the
+ * process of the writer is gone.
+ *
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#include "elite.h"
+
+/**
+ * number of tries to copy an entry that is written at the same time
+ **/
+#define ELITE_READ_TRIES 4
+
+/**
+ * returns an entry of a part
+ * @param *pool - the pool of the part
+ * @param index - index of the entry, below ELITE_SIZE
+ * @return pointer to the entry
+ **/
+static EliteEntry *eliteEntry(ElitePool *pool, int index) {
+    return (EliteEntry *) (pool->entries + (size_t) index * pool->stride);
+}
+
+/**
+ * checks if the writer of an odd entry died
+ * @param lock - lock of the entry
+ * @return integer 1 if the process of the writer is gone, integer 0 otherwise
+ **/
+static int writerGone(uint64_t lock) {
+    pid_t pid = (pid_t) (lock >> 32);
+    return pid != 0 && kill(pid, 0) == -1 && errno == ESRCH;
+}
+
+/**
+ * creates the shared memory object of the elite colorings
+ * @brief all entries start empty
+ * @param *name - name of the shared memory object
+ * @param *vertices - number of vertices of every part
+ * @param parts - number of parts, at most MAX_PARTS
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int eliteCreateShared(const char *name, const int *vertices, int parts) {
+    EliteHeader header;
+    memset(&header, 0, sizeof(header));
+    header.parts = parts;
+
+    size_t size = (sizeof(EliteHeader) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    for (int i = 0; i < parts; i++) {
+        header.vertices[i] = vertices[i];
+        header.stride[i] = (sizeof(EliteEntry) + vertices[i] + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+        header.offsets[i] = size;
+        size += ELITE_SIZE * header.stride[i];
+    }
+
+    int shmfd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (shmfd == -1) {
+        return -1;
+    }
+
+    if (ftruncate(shmfd, size) < 0) {
+        close(shmfd);
+        shm_unlink(name);
+        return -1;
+    }
+
+    unsigned char *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+    close(shmfd);
+    if (memory == MAP_FAILED) {
+        shm_unlink(name);
+        return -1;
+    }
+
+    memcpy(memory, &header, sizeof(header));
+    for (int i = 0; i < parts; i++) {
+        for (int j = 0; j < ELITE_SIZE; j++) {
+            EliteEntry *entry = (EliteEntry *) (memory + header.offsets[i] + j * header.stride[i]);
+            entry->lock = 0;
+            entry->conflicts = INT_MAX;
+        }
+    }
+    munmap(memory, size);
+    return 1;
+}
+
+/**
+ * maps the elite colorings of one part
+ * @param *pool - the view of the part
+ * @param *name - name of the shared memory object
+ * @param part - index of the part
+ * @param vertices - number of vertices of the part, checked against the object
+ * @return integer 1 if success, integer -1 if failure or if the object has no such part
+ **/
+int eliteAttachShared(ElitePool *pool, const char *name, int part, int vertices) {
+    int shmfd = shm_open(name, O_RDWR, 0600);
+    if (shmfd == -1) {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(shmfd, &st) == -1 || st.st_size < (off_t) sizeof(EliteHeader)) {
+        close(shmfd);
+        return -1;
+    }
+
+    void *memory = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+    close(shmfd);
+    if (memory == MAP_FAILED) {
+        return -1;
+    }
+
+    const EliteHeader *header = memory;
+    if (part < 0 || part >= header->parts || header->vertices[part] != vertices) {
+        munmap(memory, st.st_size);
+        return -1;
+    }
+
+    pool->memory = memory;
+    pool->size = st.st_size;
+    pool->entries = (unsigned char *) memory + header->offsets[part];
+    pool->stride = header->stride[part];
+    pool->vertices = vertices;
+    return 1;
+}
+
+/**
+ * unmaps the elite colorings
+ * @param *pool - the view of the part
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int eliteClose(ElitePool *pool) {
+    return munmap(pool->memory, pool->size) == -1 ? -1 : 1;
+}
+
+/**
+ * migrates a coloring into the pool
+ * @brief the coloring replaces the entry with the most conflicts if it has less, an entry
+ * left odd by a dead writer counts as empty. If another generator writes that entry at
+ * the same time the coloring is dropped.
+ * @param *pool - the view of the part
+ * @param *colors - color of every vertex
+ * @param conflicts - number of conflicts of the coloring
+ * @return integer 1 if the coloring was stored, integer 0 otherwise
+ **/
+int eliteMigrate(ElitePool *pool, const int *colors, int conflicts) {
+    int worst = -1;
+    uint64_t worst_lock = 0;
+    int worst_conflicts = conflicts;
+    for (int i = 0; i < ELITE_SIZE; i++) {
+        EliteEntry *entry = eliteEntry(pool, i);
+        uint64_t lock = __atomic_load_n(&entry->lock, __ATOMIC_ACQUIRE);
+        int current = __atomic_load_n(&entry->conflicts, __ATOMIC_RELAXED);
+        if (lock & 1) {
+            if (!writerGone(lock)) {
+                continue;
+            }
+            current = INT_MAX;
+        }
+        if (current > worst_conflicts) {
+            worst = i;
+            worst_lock = lock;
+            worst_conflicts = current;
+        }
+    }
+    if (worst == -1) {
+        return 0;
+    }
+
+    // the version stays odd when the entry of a dead writer is taken over
+    uint32_t version = ((uint32_t) worst_lock + 1) | 1;
+    uint64_t owner = (uint64_t) (uint32_t) getpid() << 32;
+    EliteEntry *entry = eliteEntry(pool, worst);
+    if (!__atomic_compare_exchange_n(&entry->lock, &worst_lock, owner | version, 0,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+
+    __atomic_store_n(&entry->conflicts, conflicts, __ATOMIC_RELAXED);
+    for (int v = 0; v < pool->vertices; v++) {
+        entry->colors[v] = colors[v];
+    }
+    __atomic_store_n(&entry->lock, owner | (uint32_t) (version + 1), __ATOMIC_RELEASE);
+    return 1;
+}
+
+/**
+ * copies a random coloring of the pool
+ * @brief starts at a random entry and takes the first one that is not empty. An entry
+ * that changes while it is copied is tried again a few times, then the next one is taken.
+ * @param *pool - the view of the part
+ * @param *rng - random number stream of the generator
+ * @param *colors - space for the color of every vertex
+ * @return number of conflicts of the copied coloring, integer -1 if the pool is empty
+ **/
+int eliteSample(ElitePool *pool, Rng *rng, uint8_t *colors) {
+    int start = rngBelow(rng, ELITE_SIZE);
+    for (int i = 0; i < ELITE_SIZE; i++) {
+        EliteEntry *entry = eliteEntry(pool, (start + i) % ELITE_SIZE);
+
+        for (int try = 0; try < ELITE_READ_TRIES; try++) {
+            uint64_t lock = __atomic_load_n(&entry->lock, __ATOMIC_ACQUIRE);
+            int conflicts = __atomic_load_n(&entry->conflicts, __ATOMIC_RELAXED);
+            if (lock & 1) {
+                continue;
+            }
+            if (conflicts == INT_MAX) {
+                break;
+            }
+
+            memcpy(colors, entry->colors, pool->vertices);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&entry->lock, __ATOMIC_RELAXED) == lock) {
+                return conflicts;
+            }
+        }
+    }
+    return -1;
+}
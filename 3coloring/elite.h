@@ -0,0 +1,66 @@
+/**
+ * @file elite.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Contains structs for elite.c
+ *
+ **/
+
+#ifndef ELITE_H
+#define ELITE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "structs.h"
+#include "rng.h"
+
+/**
+ * number of colorings kept for every part of the graph
+ * */
+#define ELITE_SIZE 8
+
+// One coloring of the pool, entries start on a cache line
+// lock holds the version in its low and the process of the last writer in its high 32 bits,
+// the version is even while the entry is stable and odd while a generator writes it,
+// a writer takes the entry by moving it from an even to an odd version, an entry that is
+// still odd after the process of its writer is gone is taken over the same way
+// conflicts is the number of conflicts of the coloring, INT_MAX while the entry is empty
+// colors holds the color of every vertex of the part
+struct EliteEntry {
+    uint64_t lock;
+    int conflicts;
+    uint8_t colors[];
+};
+typedef struct EliteEntry EliteEntry;
+
+// Header of the shared memory object of the elite colorings
+// the ELITE_SIZE entries of part i start offsets[i] bytes after the start of the object,
+// they are stride[i] bytes apart and hold vertices[i] colors each
+struct EliteHeader {
+    int parts;
+    int vertices[MAX_PARTS];
+    size_t stride[MAX_PARTS];
+    size_t offsets[MAX_PARTS];
+};
+typedef struct EliteHeader EliteHeader;
+
+// View of the elite colorings of one part in a generator
+// memory and size describe the whole mapping, entries points to the first entry of the part
+struct ElitePool {
+    void *memory;
+    size_t size;
+    unsigned char *entries;
+    size_t stride;
+    int vertices;
+};
+typedef struct ElitePool ElitePool;
+
+int eliteCreateShared(const char *name, const int *vertices, int parts);
+int eliteAttachShared(ElitePool *pool, const char *name, int part, int vertices);
+int eliteClose(ElitePool *pool);
+int eliteMigrate(ElitePool *pool, const int *colors, int conflicts);
+int eliteSample(ElitePool *pool, Rng *rng, uint8_t *colors);
+
+#endif
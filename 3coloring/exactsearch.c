@@ -0,0 +1,527 @@
+/**
+ * @file exactsearch.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Exact engine. Depth first branch and bound over the k-colorings that minimizes
+ * the number of edges between vertices of the same color. Like DSATUR the next vertex is
+ * the uncolored one that is most constrained by its colored neighbours, its colors are
+ * tried cheapest first. A node is cut off if its conflicts plus a lower bound for the
+ * uncolored vertices reach the bound, which is the best solution known to the supervisor.
+ * When the search is exhausted no coloring below the bound exists, so the best solution
+ * is optimal.
+ * The workers of a process share the tree by work stealing: every worker has a deque of
+ * subtrees, a worker that runs out of work steals the oldest subtree of another worker,
+ * and a busy worker gives the remaining colors of its current vertex away as subtrees
+ * while somebody is idle.
+ *
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "exactsearch.h"
+
+/**
+ * returns the cheapest color of a vertex
+ * @param *es - pointer to the search state
+ * @param v - the vertex
+ * @return smallest number of colored neighbours with the same color over all colors
+ **/
+static int minGamma(ExactSearch *es, int v) {
+    int *gamma = &es->gamma[v * es->colorCount];
+    int min = gamma[0];
+    for (int c = 1; c < es->colorCount; c++) {
+        if (gamma[c] < min) {
+            min = gamma[c];
+        }
+    }
+    return min;
+}
+
+/**
+ * colors an uncolored vertex
+ * @brief adds its conflicts to the cost, updates the colored neighbour counts and the
+ * lower bound of the uncolored neighbours and appends the vertex to the path
+ * @param *es - pointer to the search state
+ * @param v - the vertex
+ * @param color - the color
+ **/
+static void colorVertex(ExactSearch *es, int v, int color) {
+    const Graph *graph = es->graph;
+    es->lower -= minGamma(es, v);
+    es->cost += es->gamma[v * es->colorCount + color];
+    es->colors[v] = color;
+    es->path[es->assigned++] = v;
+    if (color == es->used) {
+        es->used++;
+    }
+
+    for (int i = graph->offsets[v]; i < graph->offsets[v + 1]; i++) {
+        int u = graph->adjacent[i];
+        if (es->colors[u] == -1) {
+            int before = minGamma(es, u);
+            es->gamma[u * es->colorCount + color]++;
+            es->lower += minGamma(es, u) - before;
+        } else {
+            es->gamma[u * es->colorCount + color]++;
+        }
+    }
+}
+
+/**
+ * removes the color of the last vertex of the path
+ * @param *es - pointer to the search state
+ * @param used - number of used colors before the vertex was colored
+ **/
+static void uncolorVertex(ExactSearch *es, int used) {
+    const Graph *graph = es->graph;
+    int v = es->path[--es->assigned];
+    int color = es->colors[v];
+
+    for (int i = graph->offsets[v]; i < graph->offsets[v + 1]; i++) {
+        int u = graph->adjacent[i];
+        if (es->colors[u] == -1) {
+            int before = minGamma(es, u);
+            es->gamma[u * es->colorCount + color]--;
+            es->lower += minGamma(es, u) - before;
+        } else {
+            es->gamma[u * es->colorCount + color]--;
+        }
+    }
+
+    es->colors[v] = -1;
+    es->cost -= es->gamma[v * es->colorCount + color];
+    es->lower += minGamma(es, v);
+    es->used = used;
+}
+
+/**
+ * selects the next vertex
+ * @brief the uncolored vertex with the most expensive cheapest color, then with the
+ * most colors among its colored neighbours (saturation), then with the highest degree
+ * @param *es - pointer to the search state
+ * @return the vertex
+ **/
+static int selectVertex(ExactSearch *es) {
+    const Graph *graph = es->graph;
+    int best = -1;
+    int best_min = -1, best_saturation = -1, best_degree = -1;
+
+    for (int v = 0; v < graph->vertices; v++) {
+        if (es->colors[v] != -1) {
+            continue;
+        }
+        int *gamma = &es->gamma[v * es->colorCount];
+        int min = minGamma(es, v);
+        int saturation = 0;
+        for (int c = 0; c < es->colorCount; c++) {
+            saturation += gamma[c] > 0;
+        }
+        int degree = graph->offsets[v + 1] - graph->offsets[v];
+
+        if (min > best_min
+            || (min == best_min && saturation > best_saturation)
+            || (min == best_min && saturation == best_saturation && degree > best_degree)) {
+            best = v;
+            best_min = min;
+            best_saturation = saturation;
+            best_degree = degree;
+        }
+    }
+    return best;
+}
+
+/**
+ * opens a new level of the path for a vertex
+ * @brief the colors are the used ones and one new color, ordered by their conflicts
+ * @param *es - pointer to the search state
+ * @param v - the vertex
+ **/
+static void pushFrame(ExactSearch *es, int v) {
+    ExactFrame *frame = &es->frames[es->top++];
+    frame->vertex = v;
+    frame->count = es->used < es->colorCount ? es->used + 1 : es->colorCount;
+    frame->next = 0;
+    frame->colored = 0;
+    frame->used = es->used;
+
+    for (int c = 0; c < frame->count; c++) {
+        int i = c;
+        while (i > 0 && es->gamma[v * es->colorCount + frame->order[i - 1]] > es->gamma[v * es->colorCount + c]) {
+            frame->order[i] = frame->order[i - 1];
+            i--;
+        }
+        frame->order[i] = c;
+    }
+}
+
+/**
+ * adds a task to the tail of a deque
+ * @param *deque - pointer to the deque
+ * @param *task - the task
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int dequePush(ExactDeque *deque, const ExactTask *task) {
+    pthread_mutex_lock(&deque->lock);
+    if (deque->tail == deque->capacity) {
+        int length = deque->tail - deque->head;
+        if (deque->head > 0) {
+            memmove(deque->tasks, deque->tasks + deque->head, length * sizeof(ExactTask));
+        } else {
+            int capacity = deque->capacity == 0 ? 16 : deque->capacity * 2;
+            ExactTask *tasks = realloc(deque->tasks, capacity * sizeof(ExactTask));
+            if (tasks == NULL) {
+                pthread_mutex_unlock(&deque->lock);
+                return -1;
+            }
+            deque->tasks = tasks;
+            deque->capacity = capacity;
+        }
+        deque->head = 0;
+        deque->tail = length;
+    }
+    deque->tasks[deque->tail++] = *task;
+    pthread_mutex_unlock(&deque->lock);
+    return 1;
+}
+
+/**
+ * removes a task from a deque
+ * @param *deque - pointer to the deque
+ * @param *task - the task is written to it
+ * @param steal - integer 1 to take the oldest task at the head, integer 0 for the tail
+ * @param *idle - idle counter that is decremented together with the removal or NULL
+ * @return integer 1 if a task was removed, integer 0 if the deque is empty
+ **/
+static int dequeTake(ExactDeque *deque, ExactTask *task, int steal, int *idle) {
+    pthread_mutex_lock(&deque->lock);
+    if (deque->head == deque->tail) {
+        pthread_mutex_unlock(&deque->lock);
+        return 0;
+    }
+    *task = steal ? deque->tasks[deque->head++] : deque->tasks[--deque->tail];
+    if (deque->head == deque->tail) {
+        deque->head = 0;
+        deque->tail = 0;
+    }
+    // a thief stops being idle before the task leaves the deque, so the other
+    // workers never see all workers idle while a task exists
+    if (idle != NULL) {
+        __atomic_fetch_sub(idle, 1, __ATOMIC_SEQ_CST);
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return 1;
+}
+
+/**
+ * gives the remaining colors of a level away
+ * @brief every color after the next one becomes a task with the current path,
+ * the worker itself continues with the next color only
+ * @param *es - pointer to the search state
+ * @param *frame - the level
+ **/
+static void donate(ExactSearch *es, ExactFrame *frame) {
+    ExactDeque *deque = &es->pool->deques[es->index];
+    int length = es->assigned + 1;
+
+    while (frame->count > frame->next + 1) {
+        ExactTask task;
+        task.length = length;
+        task.vertices = malloc(2 * length * sizeof(int));
+        if (task.vertices == NULL) {
+            return;
+        }
+        task.colors = task.vertices + length;
+        for (int i = 0; i < es->assigned; i++) {
+            task.vertices[i] = es->path[i];
+            task.colors[i] = es->colors[es->path[i]];
+        }
+        task.vertices[length - 1] = frame->vertex;
+        task.colors[length - 1] = frame->order[frame->count - 1];
+
+        if (dequePush(deque, &task) == -1) {
+            free(task.vertices);
+            return;
+        }
+        frame->count--;
+    }
+}
+
+/**
+ * checks if the worker should give work away
+ * @param *es - pointer to the search state
+ * @return integer 1 if another worker is idle and the own deque is empty
+ **/
+static int shouldDonate(ExactSearch *es) {
+    ExactDeque *deque = &es->pool->deques[es->index];
+    return __atomic_load_n(&es->pool->idle, __ATOMIC_RELAXED) > 0
+           && __atomic_load_n(&deque->tail, __ATOMIC_RELAXED) == __atomic_load_n(&deque->head, __ATOMIC_RELAXED);
+}
+
+/**
+ * gets the next task
+ * @brief takes the newest own task, otherwise steals the oldest task of another worker.
+ * Without any task the worker waits as idle worker until it can steal one, until all
+ * workers are idle or until the supervisor terminates.
+ * @param *es - pointer to the search state
+ * @param *task - the task is written to it
+ * @return integer 1 if a task was taken, integer 0 if the search is exhausted,
+ * integer -1 if the supervisor terminates
+ **/
+static int takeTask(ExactSearch *es, ExactTask *task) {
+    ExactPool *pool = es->pool;
+    if (dequeTake(&pool->deques[es->index], task, 0, NULL)) {
+        return 1;
+    }
+
+    __atomic_fetch_add(&pool->idle, 1, __ATOMIC_SEQ_CST);
+    while (1) {
+        if (__atomic_load_n(pool->stop, __ATOMIC_ACQUIRE)) {
+            return -1;
+        }
+
+        int workers = __atomic_load_n(&pool->workers, __ATOMIC_ACQUIRE);
+        for (int i = 1; i < workers; i++) {
+            ExactDeque *victim = &pool->deques[(es->index + i) % workers];
+            if (dequeTake(victim, task, 1, &pool->idle)) {
+                return 1;
+            }
+        }
+
+        if (__atomic_load_n(&pool->idle, __ATOMIC_SEQ_CST) == workers) {
+            return 0;
+        }
+
+        struct timespec pause = { 0, 100000 };
+        nanosleep(&pause, NULL);
+    }
+}
+
+/**
+ * starts a task
+ * @brief removes the path of the last task and colors the vertices of the new one
+ * @param *es - pointer to the search state
+ * @param *task - the task, its memory is freed
+ **/
+static void startTask(ExactSearch *es, ExactTask *task) {
+    while (es->assigned > 0) {
+        uncolorVertex(es, 0);
+    }
+    for (int i = 0; i < task->length; i++) {
+        colorVertex(es, task->vertices[i], task->colors[i]);
+        if (task->colors[i] >= es->used) {
+            es->used = task->colors[i] + 1;
+        }
+    }
+    free(task->vertices);
+
+    es->base = es->assigned;
+    es->top = 0;
+    es->active = 1;
+}
+
+/**
+ * tries the next color of the deepest level
+ * @brief uncolors the vertex of the level and colors it with the next color whose
+ * node is not cut off by the bound
+ * @param *es - pointer to the search state
+ * @return integer 1 if the vertex got a new color, integer 0 if all colors are done
+ **/
+static int advance(ExactSearch *es) {
+    ExactFrame *frame = &es->frames[es->top - 1];
+    if (frame->colored) {
+        uncolorVertex(es, frame->used);
+        frame->colored = 0;
+    }
+
+    while (frame->next < frame->count) {
+        if (frame->next + 1 < frame->count && shouldDonate(es)) {
+            donate(es, frame);
+        }
+
+        colorVertex(es, frame->vertex, frame->order[frame->next++]);
+        if (es->cost + es->lower < es->bound) {
+            frame->colored = 1;
+            return 1;
+        }
+        uncolorVertex(es, frame->used);
+    }
+    return 0;
+}
+
+/**
+ * initializes the shared search tree
+ * @brief the whole tree is one task in the deque of the first worker
+ * @param *pool - pointer to the pool
+ * @param *graph - the graph, it has to stay valid until the pool is freed
+ * @param colorCount - number of colors, between 2 and MAX_COLORS
+ * @param workers - number of workers
+ * @param *stop - the search stops when it becomes 1
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int exactPoolInit(ExactPool *pool, const Graph *graph, int colorCount, int workers, const int *stop) {
+    pool->graph = graph;
+    pool->colorCount = colorCount;
+    pool->workers = workers;
+    pool->idle = 0;
+    pool->reported = 0;
+    pool->stop = stop;
+    pool->deques = calloc(workers, sizeof(ExactDeque));
+    if (pool->deques == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < workers; i++) {
+        pthread_mutex_init(&pool->deques[i].lock, NULL);
+    }
+
+    ExactTask root = { 0, NULL, NULL };
+    if (dequePush(&pool->deques[0], &root) == -1) {
+        exactPoolFree(pool);
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * frees the shared search tree
+ * @param *pool - pointer to the pool
+ **/
+void exactPoolFree(ExactPool *pool) {
+    int workers = pool->workers;
+    for (int i = 0; i < workers; i++) {
+        ExactDeque *deque = &pool->deques[i];
+        for (int j = deque->head; j < deque->tail; j++) {
+            free(deque->tasks[j].vertices);
+        }
+        free(deque->tasks);
+        pthread_mutex_destroy(&deque->lock);
+    }
+    free(pool->deques);
+}
+
+/**
+ * decides which worker reports the exhausted search
+ * @param *pool - pointer to the pool
+ * @return integer 1 for the first caller, integer 0 for all others
+ **/
+int exactPoolReport(ExactPool *pool) {
+    return __atomic_exchange_n(&pool->reported, 1, __ATOMIC_ACQ_REL) == 0;
+}
+
+/**
+ * initializes a worker of the search
+ * @param *es - pointer to the search state
+ * @param *pool - the shared search tree
+ * @param index - index of the worker in the pool
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int exactSearchInit(ExactSearch *es, ExactPool *pool, int index) {
+    memset(es, 0, sizeof(*es));
+    const Graph *graph = pool->graph;
+    es->pool = pool;
+    es->index = index;
+    es->graph = graph;
+    es->colorCount = pool->colorCount;
+    es->cost = graph->selfLoops;
+    es->bound = graph->length + 1;
+
+    int vertices = graph->vertices;
+    es->colors = malloc((vertices + 1) * sizeof(int));
+    es->gamma = calloc(es->colorCount * vertices + 1, sizeof(int));
+    es->path = malloc((vertices + 1) * sizeof(int));
+    es->frames = malloc((vertices + 1) * sizeof(ExactFrame));
+    if (es->colors == NULL || es->gamma == NULL || es->path == NULL || es->frames == NULL) {
+        exactSearchFree(es);
+        return -1;
+    }
+    for (int v = 0; v < vertices; v++) {
+        es->colors[v] = -1;
+    }
+    return 1;
+}
+
+/**
+ * frees a worker of the search
+ * @param *es - pointer to the search state
+ **/
+void exactSearchFree(ExactSearch *es) {
+    free(es->colors);
+    free(es->gamma);
+    free(es->path);
+    free(es->frames);
+}
+
+/**
+ * runs the search for a number of nodes
+ * @brief continues the depth first search of the current task and takes a new task
+ * when it is done. A complete coloring below the bound lowers the bound to its conflicts
+ * and is returned, the next call continues after it.
+ * @param *es - pointer to the search state
+ * @param nodes - maximum number of visited nodes
+ * @return EXACT_FOUND if a coloring below the bound was found, EXACT_RUNNING if the nodes
+ * are used up, EXACT_DONE if the search of all workers is exhausted, EXACT_STOPPED if
+ * the supervisor terminates
+ **/
+int exactSearchRun(ExactSearch *es, long nodes) {
+    int vertices = es->graph->vertices;
+
+    for (long n = 0; n < nodes; n++, es->nodes++) {
+        if (!es->active) {
+            ExactTask task;
+            int taken = takeTask(es, &task);
+            if (taken != 1) {
+                return taken == 0 ? EXACT_DONE : EXACT_STOPPED;
+            }
+
+            startTask(es, &task);
+            if (es->cost + es->lower >= es->bound) {
+                es->active = 0;
+            } else if (es->assigned == vertices) {
+                es->active = 0;
+                es->bound = es->cost;
+                return EXACT_FOUND;
+            } else {
+                pushFrame(es, selectVertex(es));
+            }
+            continue;
+        }
+
+        if (es->top == 0) {
+            es->active = 0;
+            continue;
+        }
+
+        if (advance(es)) {
+            if (es->assigned == vertices) {
+                es->bound = es->cost;
+                return EXACT_FOUND;
+            }
+            pushFrame(es, selectVertex(es));
+        } else {
+            es->top--;
+        }
+    }
+    return EXACT_RUNNING;
+}
+
+/**
+ * writes the coloring found by exactSearchRun as solution
+ * @param *es - pointer to the search state
+ * @param *solution - array of capacity edges
+ * @param capacity - maximum number of edges of a solution
+ * @return number of edges of the solution
+ **/
+int exactSearchSolution(ExactSearch *es, Edge *solution, int capacity) {
+    const Graph *graph = es->graph;
+    int length = 0;
+    for (int i = 0; i < graph->length && length < capacity; i++) {
+        if (es->colors[graph->from[i]] == es->colors[graph->to[i]]) {
+            solution[length].from = graph->from[i];
+            solution[length].to = graph->to[i];
+            length++;
+        }
+    }
+    return length;
+}
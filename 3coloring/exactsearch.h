@@ -0,0 +1,117 @@
+/**
+ * @file exactsearch.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Exact engine, branch and bound over all k-colorings shared by the worker threads.
+ *
+ **/
+
+#ifndef EXACTSEARCH_H
+#define EXACTSEARCH_H
+
+#include <pthread.h>
+
+#include "structs.h"
+#include "graph.h"
+
+/**
+ * results of exactSearchRun
+ * */
+#define EXACT_RUNNING 0
+#define EXACT_FOUND 1
+#define EXACT_DONE 2
+#define EXACT_STOPPED 3
+
+// Subtree of the search, given by the colored vertices on the path to it
+// vertices and colors hold length entries each and are allocated together
+struct ExactTask {
+    int length;
+    int *vertices;
+    int *colors;
+};
+typedef struct ExactTask ExactTask;
+
+// Tasks of one worker, the worker takes the deepest task at the tail,
+// other workers steal the largest one at the head
+struct ExactDeque {
+    pthread_mutex_t lock;
+    ExactTask *tasks;
+    int head;
+    int tail;
+    int capacity;
+};
+typedef struct ExactDeque ExactDeque;
+
+// Search tree shared by the workers of a process
+// workers is the number of workers, idle the number of workers without a task,
+// the search is exhausted when all workers are idle
+// stop points to the terminate flag of the supervisor, reported is set by the first
+// worker that reports the exhausted search, color count is the number of colors
+struct ExactPool {
+    const Graph *graph;
+    int colorCount;
+    ExactDeque *deques;
+    int workers;
+    int idle;
+    int reported;
+    const int *stop;
+};
+typedef struct ExactPool ExactPool;
+
+// One level of the search path
+// vertex is the branched vertex, order holds the colors to try, cheapest first,
+// next is the index of the next color, colored is set while vertex has order[next - 1],
+// used is the number of used colors before the vertex was colored
+struct ExactFrame {
+    int vertex;
+    int order[MAX_COLORS];
+    int count;
+    int next;
+    int colored;
+    int used;
+};
+typedef struct ExactFrame ExactFrame;
+
+// State of one worker of the exact search
+// colors[v] is the color of v or -1, gamma[v * k + c] the number of colored neighbours
+// of v with color c, k is the color count, path holds the colored vertices in order
+// cost is the number of conflicts between colored vertices including self loops,
+// lower is the sum of the cheapest color over all uncolored vertices, so no coloring
+// below the current node has less than cost + lower conflicts
+// used is the number of colors on the path, a vertex only gets one new color, which
+// removes the symmetric colorings
+// bound is the number of conflicts a coloring needs to be reported, the generator
+// lowers it to the bound of the supervisor
+// base is the length of the path of the current task, active is set while the worker
+// has a task, nodes counts the visited nodes
+struct ExactSearch {
+    ExactPool *pool;
+    int index;
+    const Graph *graph;
+    int colorCount;
+    int *colors;
+    int *gamma;
+    int *path;
+    int assigned;
+    ExactFrame *frames;
+    int top;
+    int cost;
+    int lower;
+    int used;
+    int bound;
+    int base;
+    int active;
+    long nodes;
+};
+typedef struct ExactSearch ExactSearch;
+
+int exactPoolInit(ExactPool *pool, const Graph *graph, int colorCount, int workers, const int *stop);
+void exactPoolFree(ExactPool *pool);
+int exactPoolReport(ExactPool *pool);
+int exactSearchInit(ExactSearch *es, ExactPool *pool, int index);
+void exactSearchFree(ExactSearch *es);
+int exactSearchRun(ExactSearch *es, long nodes);
+int exactSearchSolution(ExactSearch *es, Edge *solution, int capacity);
+
+#endif
@@ -0,0 +1,191 @@
+/**
+ * @file genbench.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Microbenchmark for the random engine. Builds a random graph and measures
+ * how many colorings the random engine generates per second with the bound a generator
+ * starts with, and how many full scans over all edges the conflict kernel does per
+ * second, for the scalar and for the selected conflict kernel.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "structs.h"
+#include "graph.h"
+#include "kernel.h"
+#include "randomsearch.h"
+#include "rng.h"
+
+/**
+ * Pointer to name of program
+ **/
+static char *program_name;
+
+/**
+ * printUsageError function.
+ * @brief Usage of program is printed to stderr and program is exited with failure code
+ * @details global variables: program_name, contains the name of the program
+ **/
+static void printUsageError(void) {
+
+    fprintf(stderr, "Usage: %s [-n CALLS] [-v VERTICES] [-m EDGES] [-k COLORS]\n", program_name);
+    exit(EXIT_FAILURE);
+
+}
+
+/**
+ * returns the current time
+ * @return monotonic time in seconds
+ **/
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * parses a positive number
+ * @param *text - the number as text
+ * @return the number, the usage is printed if it is not a positive number
+ **/
+static long parsePositive(const char *text) {
+    char *endptr;
+    long value = strtol(text, &endptr, 10);
+    if (*endptr != '\0' || value <= 0 || value > INT_MAX) { printUsageError(); }
+    return value;
+}
+
+/**
+ * measures the random engine
+ * @param *rs - pointer to the workspace
+ * @param bound - bound passed to every call
+ * @param calls - number of calls
+ * @return calls per second
+ **/
+static double measure(RandomSearch *rs, int bound, long calls) {
+    Edge solution[DEFAULT_SOLUTION_SIZE];
+    long found = 0;
+
+    double start = now();
+    for (long i = 0; i < calls; i++) {
+        if (randomSearchGenerate(rs, bound, DEFAULT_SOLUTION_SIZE, solution) != -1) {
+            found++;
+        }
+    }
+    double elapsed = now() - start;
+
+    // keeps the calls from being optimized away
+    if (found < 0) {
+        fprintf(stderr, "%s: Impossible number of solutions.\n", program_name);
+    }
+    return calls / elapsed;
+}
+
+/**
+ * measures the conflict kernel alone
+ * @brief counts the conflicts of all edges for the current coloring of the workspace
+ * @param *rs - pointer to the workspace
+ * @param calls - number of full scans
+ * @return full scans per second
+ **/
+static double measureScan(RandomSearch *rs, long calls) {
+    const Graph *graph = rs->graph;
+    long conflicts = 0;
+
+    double start = now();
+    for (long i = 0; i < calls; i++) {
+        conflicts += rs->kernel(graph->from, graph->to, rs->colors, 0, graph->length);
+    }
+    double elapsed = now() - start;
+
+    if (conflicts < 0) {
+        fprintf(stderr, "%s: Impossible number of conflicts.\n", program_name);
+    }
+    return calls / elapsed;
+}
+
+/**
+ * Program entry point.
+ * @brief The program starts here. Builds a random graph with a fixed seed and prints
+ * the calls per second of the random engine as CSV. -k sets the number of colors, default 3.
+ * @param argc The argument counter.
+ * @param argv The argument vector.
+ * @return Returns EXIT_SUCCESS or EXIT_FAILURE
+ **/
+int main(int argc, char *argv[]) {
+    program_name = argv[0];
+
+    long calls = 20000;
+    long vertices = 1000;
+    long length = 5000;
+    long colors = DEFAULT_COLORS;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:v:m:k:")) != -1) {
+        switch (option) {
+            case 'n':
+                calls = parsePositive(optarg);
+                break;
+            case 'v':
+                vertices = parsePositive(optarg);
+                break;
+            case 'm':
+                length = parsePositive(optarg);
+                break;
+            case 'k':
+                colors = parsePositive(optarg);
+                if (colors < 2 || colors > MAX_COLORS) { printUsageError(); }
+                break;
+            default:
+                printUsageError();
+        }
+    }
+    if (optind != argc || vertices < 2) { printUsageError(); }
+
+    Edge *edges = malloc(length * sizeof(Edge));
+    if (edges == NULL) {
+        exit(EXIT_FAILURE);
+    }
+
+    Rng rng;
+    rngSeed(&rng, 1, 0);
+    for (long i = 0; i < length; i++) {
+        edges[i].from = rngBelow(&rng, vertices);
+        do {
+            edges[i].to = rngBelow(&rng, vertices);
+        } while (edges[i].to == edges[i].from);
+    }
+
+    Graph graph;
+    int created = graphCreateLocal(&graph, edges, length);
+    free(edges);
+    if (created == -1) {
+        exit(EXIT_FAILURE);
+    }
+
+    ConflictKernel kernels[2] = { countConflictsScalar, kernelSelect() };
+
+    fprintf(stdout, "kernel,vertices,edges,colors,measure,calls_per_sec\n");
+    for (int k = 0; k < 2; k++) {
+        RandomSearch rs;
+        if (randomSearchInit(&rs, &graph, colors, kernels[k], 1, 0) == -1) {
+            graphClose(&graph);
+            exit(EXIT_FAILURE);
+        }
+
+        fprintf(stdout, "%s,%ld,%ld,%ld,generate,%.0f\n", kernelName(kernels[k]), vertices, length,
+                colors, measure(&rs, DEFAULT_SOLUTION_SIZE + 1, calls));
+        fprintf(stdout, "%s,%ld,%ld,%ld,full_scan,%.0f\n", kernelName(kernels[k]), vertices, length,
+                colors, measureScan(&rs, calls));
+        randomSearchFree(&rs);
+    }
+
+    graphClose(&graph);
+    exit(EXIT_SUCCESS);
+}
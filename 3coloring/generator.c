@@ -4,23 +4,32 @@
  * @date 21.11.2020
  *
  * @brief Generator module. Pushes continuously solutions
- * of the 3 color problem to the circular buffer.
+ * of the k color problem to the circular buffer.
  *
  **/
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <time.h>
 #include <unistd.h>
 #include <sys/types.h>
-#include <semaphore.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <fcntl.h>
 #include <errno.h>
 
 #include "structs.h"
+#include "ring.h"
 #include "generator.h"
+#include "graph.h"
+#include "randomsearch.h"
+#include "localsearch.h"
+#include "exactsearch.h"
+#include "affinity.h"
+#include "elite.h"
+#include "instance.h"
 
 /**
  * Pointer to name of program
@@ -34,214 +43,638 @@ static char *program_name;
  **/
 static void printUsageError(void) {
 
-    fprintf(stderr, "Usage: %s EDGE1...\n", program_name);
+    fprintf(stderr, "Usage: %s [-e random|local|exact [-i]] [-b BATCH] [-s SEED] [-I INSTANCE] [-t THREADS [-p]] [EDGE1...]\n", program_name);
     exit(EXIT_FAILURE);
 
 }
 
 /**
- * Returns Minimum
- * @brief returns the smaller number from params
- * @param a - first integer
- * @param b - second integer
+ * checks if the supervisor terminates
+ * @param *ring - pointer to the circular buffer
+ * @return integer 1 if the terminate flag is set, integer 0 otherwise
  **/
-static int getMinimum( int a, int b ) {
-    if ( a < b ) { return a; }
-    else { return b; }
+static int isTerminated(Ring *ring) {
+    return __atomic_load_n(&ring->shm->terminate, __ATOMIC_ACQUIRE) == 1;
 }
 
 /**
- * Adds new edge to the array
- * @brief reallocate memory, adds new edge to edge array and updates length of array
- * @param *edges - pointer to the edges array
- * @param *edge - pointer to the new edge
- * @return integer 1 if successful, integer -1 if failure
+ * returns the bound for new solutions
+ * @param *worker - pointer to the worker
+ * @return the smaller one of the bound of the supervisor for the part of the graph and
+ * the best solution of the process
  **/
-static int addToArray(EdgeArray *edges, Edge edge) {
-    Edge *new_array_length = realloc(edges->content, (edges->length + 1) * sizeof(Edge));
+static int currentBound(Worker *worker) {
+    ShmObj *shm = worker->ring->shm;
+    int part = worker->graph->part;
+    int bound = __atomic_load_n(part >= 0 ? &shm->partBound[part] : &shm->bestBound, __ATOMIC_RELAXED);
+    int best = __atomic_load_n(worker->best, __ATOMIC_RELAXED);
+    return best < bound ? best : bound;
+}
 
-    if (new_array_length == NULL) {
-        return -1;
+/**
+ * lowers the best solution of the process
+ * @param *best - pointer to the best number of edges of the process
+ * @param length - number of edges of a new solution
+ * @return integer 1 if the solution is better than all solutions of the process, integer 0 otherwise
+ **/
+static int lowerBest(int *best, int length) {
+    int current = __atomic_load_n(best, __ATOMIC_RELAXED);
+    while (length < current) {
+        if (__atomic_compare_exchange_n(best, &current, length, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * returns the current time
+ * @return monotonic time in nanoseconds
+ **/
+static uint64_t monotonicNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * takes a free block of counters for a worker
+ * @brief blocks of workers that exited are taken again, their counters are kept
+ * @param *shm - pointer to the shared memory object
+ * @param stream - random number stream of the worker
+ * @return pointer to the counters, NULL if all blocks are taken
+ **/
+static Stats *takeStats(ShmObj *shm, uint64_t stream) {
+    int pid = getpid();
+    for (int i = 0; i < STATS_SIZE; i++) {
+        Stats *stats = &shm->stats[i];
+        int owner = 0;
+        if (__atomic_compare_exchange_n(&stats->owner, &owner, pid, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&stats->stream, (int) (stream % INT_MAX), __ATOMIC_RELAXED);
+            __atomic_store_n(&stats->pid, pid, __ATOMIC_RELEASE);
+            return stats;
+        }
     }
+    return NULL;
+}
+
+/**
+ * forgets the slots a worker claimed
+ * @brief called after the slots were published or given back
+ * @param *worker - pointer to the worker
+ **/
+static void clearClaim(Worker *worker) {
+    __atomic_store_n(&worker->stats->claim.count, 0, __ATOMIC_RELEASE);
+}
 
-    edges->length = (edges->length) + 1;
-    edges->content = new_array_length;
-    (edges->content)[(edges->length) - 1] = edge;
+/**
+ * adds attempts to the counters of the worker
+ * @param *worker - pointer to the worker
+ * @param attempts - number of new attempts
+ **/
+static void recordAttempts(Worker *worker, uint64_t attempts) {
+    __atomic_fetch_add(&worker->stats->attempts, attempts, __ATOMIC_RELAXED);
+}
 
+/**
+ * adds published solutions to the counters of the worker
+ * @param *worker - pointer to the worker
+ * @param published - number of published solutions
+ * @param best - smallest number of edges of these solutions
+ * @param blocked - nanoseconds the worker waited for the slots
+ **/
+static void recordPublished(Worker *worker, int published, int best, uint64_t blocked) {
+    Stats *stats = worker->stats;
+    __atomic_fetch_add(&stats->published, published, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->blocked, blocked, __ATOMIC_RELAXED);
+    int current = __atomic_load_n(&stats->best, __ATOMIC_RELAXED);
+    if (published > 0 && (current == -1 || best < current)) {
+        __atomic_store_n(&stats->best, best, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * publishes solutions to the circular buffer
+ * @brief solutions that are not better than every solution the workers of this process
+ * published are dropped, so solutions are coalesced in the process and do not reach the
+ * supervisor. For the remaining ones as many slots as possible are claimed at once,
+ * the solutions are copied into the slots and every claimed batch is published at once.
+ * Only the used edges of a solution are copied, the length is written in front of them.
+ * The claimed slots are recorded in the counters of the worker until they are published,
+ * so the supervisor can publish them if the worker dies in between.
+ * @param *worker - pointer to the worker
+ * @param *solutions - solutions, solution i starts at solutions + i * solutionSize
+ * @param *lengths - number of edges of every solution
+ * @param count - number of solutions
+ * @return integer 1 if success, integer 0 if the supervisor terminates, integer -1 if failure
+ **/
+static int publishSolutions(Worker *worker, Edge *solutions, int *lengths, int count) {
+    Ring *ring = worker->ring;
+    int capacity = ring->shm->solutionSize;
+
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (lowerBest(worker->best, lengths[i])) {
+            memmove(solutions + (size_t) kept * capacity, solutions + (size_t) i * capacity,
+                    lengths[i] * sizeof(Edge));
+            lengths[kept++] = lengths[i];
+        }
+    }
+
+    int published = 0;
+    while (published < kept) {
+        uint64_t pos;
+        uint64_t start = monotonicNs();
+        int claimed = ringClaim(ring, kept - published, &pos, &worker->stats->claim);
+        uint64_t blocked = monotonicNs() - start;
+        if (claimed == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (claimed == 0) {
+            return 0;
+        }
+
+        if (isTerminated(ring)) {
+            ringUnclaim(ring, claimed);
+            clearClaim(worker);
+            return 0;
+        }
+
+        for (int i = 0; i < claimed; i++) {
+            Slot *slot = ringSlot(ring, pos + i);
+            int length = lengths[published + i];
+            slot->length = length;
+            slot->flags = 0;
+            slot->part = worker->graph->part;
+            slot->origin = (int) worker->stream;
+            memcpy(slot->edges, solutions + (size_t) (published + i) * capacity, length * sizeof(Edge));
+        }
+
+        if (ringPublish(ring, pos, claimed) == -1) {
+            return -1;
+        }
+        clearClaim(worker);
+        published += claimed;
+
+        // the kept solutions get shorter, the last one is the best
+        recordPublished(worker, claimed, lengths[published - 1], blocked);
+    }
     return 1;
 }
 
 /**
- * generates a new solution and adds the edges to the circular buffer
- * @brief adds a random coloring to the vertexes and deletes edges between vertexes with the same color.
- * As long as the solution is smaller than eight, the edges are added to the circular buffer.
- * @param *edges - pointer to the given edges
- * @param *shm_obj - pointer to the mapped shared memory object
- * @return Edge Array, array that holds the new solution
+ * tells the supervisor that the optimum is proven
+ * @brief publishes a slot with SLOT_PROVEN, all solutions of the worker are already published
+ * @param *worker - pointer to the worker
+ * @param bound - no solution of the part of the graph with less edges exists
+ * @return integer 1 if success, integer 0 if the supervisor terminates, integer -1 if failure
+ **/
+static int publishProven(Worker *worker, int bound) {
+    Ring *ring = worker->ring;
+    uint64_t pos;
+    int claimed;
+    while ((claimed = ringClaim(ring, 1, &pos, &worker->stats->claim)) == -1) {
+        if (errno != EINTR) {
+            return -1;
+        }
+    }
+    if (claimed == 0) {
+        return 0;
+    }
+    if (isTerminated(ring)) {
+        ringUnclaim(ring, claimed);
+        clearClaim(worker);
+        return 0;
+    }
+
+    Slot *slot = ringSlot(ring, pos);
+    slot->length = bound;
+    slot->flags = SLOT_PROVEN;
+    slot->part = worker->graph->part;
+    slot->origin = (int) worker->stream;
+    int status = ringPublish(ring, pos, 1);
+    clearClaim(worker);
+    return status;
+}
+
+/**
+ * random engine
+ * @brief generates random colorings with the current bound until batch solutions were
+ * found and publishes them together to the circular buffer. A batch that is not full is
+ * published as well after RANDOM_FLUSH_ATTEMPTS attempts, when the bound changed, when
+ * a solution without edges was found and before the engine returns, so no solution waits
+ * for the rest of its batch forever. The coloring and the solutions are allocated once,
+ * generating a solution does not allocate anything.
+ * @param *worker - pointer to the worker
+ * @return integer 1 if success, integer -1 if failure
  **/
-static int generate(EdgeArray *edges, ShmObj *shm_obj) {
-    int colored_nodes[edges->length];
-    for (int i = 0; i < edges->length; i++) {
-        int num = (rand() %(3)) + 1;
-        colored_nodes[i] = num;
+static int runRandom(Worker *worker) {
+    RandomSearch rs;
+    if (randomSearchInit(&rs, worker->graph, worker->ring->shm->colorCount, kernelSelect(), worker->seed, worker->stream) == -1) {
+        return -1;
+    }
+
+    int capacity = worker->ring->shm->solutionSize;
+    Edge *solutions = malloc((size_t) worker->batch * capacity * sizeof(Edge));
+    int *lengths = malloc(worker->batch * sizeof(int));
+    if (solutions == NULL || lengths == NULL) {
+        free(solutions);
+        free(lengths);
+        randomSearchFree(&rs);
+        return -1;
     }
 
-    EdgeArray *solution_edges = (EdgeArray *) malloc(sizeof(EdgeArray));
-    solution_edges->content = (Edge *) malloc(sizeof(Edge));
-    solution_edges->length = 0;
+    int exit_status = 1;
+    int pending = 0;
+    uint64_t attempts = 0;
+    uint64_t waiting = 0;
+    int bound = currentBound(worker);
+    while (!isTerminated(worker->ring)) {
+        int current = currentBound(worker);
+        int length = randomSearchGenerate(&rs, current, capacity,
+                                          solutions + (size_t) pending * capacity);
+        if (++attempts == 1024) {
+            recordAttempts(worker, attempts);
+            attempts = 0;
+        }
+        if (length != -1) {
+            lengths[pending++] = length;
+        }
+        if (pending == 0) {
+            continue;
+        }
 
-    int NumberColorConflicts = 0;
-    for (int i = 0;  i < edges->length;  i++) {
+        // the attempts since the first solution of the batch
+        waiting++;
+        if (pending < worker->batch && length != 0 && current == bound
+            && waiting < RANDOM_FLUSH_ATTEMPTS) {
+            continue;
+        }
 
-        if(colored_nodes[edges->content[i].from] == colored_nodes[edges->content[i].to]){
-            if ( NumberColorConflicts < 8 ) {
-                addToArray(solution_edges, edges->content[i]);
-            }
-            NumberColorConflicts++;
+        int published = publishSolutions(worker, solutions, lengths, pending);
+        pending = 0;
+        waiting = 0;
+        bound = currentBound(worker);
+        if (published != 1) {
+            exit_status = published;
+            break;
         }
     }
 
-    if (solution_edges->length <= 8) {
-        int solution_length = getMinimum(8, solution_edges->length);
-        for (int i = 0; i < getMinimum(8, solution_edges->length); i++) {
-            shm_obj->data[shm_obj->writePos][i] = solution_edges->content[i];
+    if (pending > 0 && publishSolutions(worker, solutions, lengths, pending) == -1) {
+        exit_status = -1;
+    }
+
+    recordAttempts(worker, attempts);
+    free(solutions);
+    free(lengths);
+    randomSearchFree(&rs);
+    return exit_status == -1 ? -1 : 1;
+}
+
+/**
+ * local search engine
+ * @brief runs the min-conflicts tabu search and publishes a solution to the circular
+ * buffer only if the search found a coloring with less conflicts than all earlier ones
+ * and than the current bound.
+ * The terminate flag is checked between rounds of moves, so the generator also stops
+ * while it does not find anything new.
+ * With an elite pool every new best coloring and the best coloring of every stalled run
+ * are migrated into the pool and a stalled run restarts from a coloring of the pool,
+ * otherwise from a random one.
+ * @param *worker - pointer to the worker
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int runLocalSearch(Worker *worker) {
+    LocalSearch ls;
+    int capacity = worker->ring->shm->solutionSize;
+    if (localSearchInit(&ls, worker->graph, worker->ring->shm->colorCount, capacity, worker->seed, worker->stream) == -1) {
+        fprintf(stderr, "%s: Couldn't initialize local search.\n", program_name);
+        return -1;
+    }
+
+    Edge *solution = malloc(capacity * sizeof(Edge));
+    uint8_t *sample = malloc(worker->graph->vertices + 1);
+    if (solution == NULL || sample == NULL) {
+        free(solution);
+        free(sample);
+        localSearchFree(&ls);
+        return -1;
+    }
+
+    int exit_status = 1;
+    while (!isTerminated(worker->ring)) {
+        int bound = currentBound(worker);
+        if (bound < ls.best) {
+            ls.best = bound;
         }
 
-        for (int i = solution_length; i < 8; i++) {
-            Edge new_edge;
+        long iteration = ls.iteration;
+        int result = localSearchRun(&ls, 4096);
+        recordAttempts(worker, ls.iteration - iteration);
+        if (result == LOCAL_STALLED) {
+            if (worker->elite == NULL) {
+                localSearchRestart(&ls);
+                continue;
+            }
+            eliteMigrate(worker->elite, localSearchRunColors(&ls), ls.runBest);
+            if (eliteSample(worker->elite, &ls.rng, sample) == -1) {
+                localSearchRestart(&ls);
+            } else {
+                localSearchRestartFrom(&ls, sample);
+            }
+            continue;
+        }
+        if (result != LOCAL_FOUND) {
+            continue;
+        }
+
+        if (worker->elite != NULL) {
+            eliteMigrate(worker->elite, ls.colors, ls.conflicts);
+        }
 
-            new_edge.from = -1;
-            new_edge.to = -1;
+        int length = localSearchSolution(&ls, solution);
 
-            shm_obj->data[shm_obj->writePos][i] = new_edge;
+        int published = publishSolutions(worker, solution, &length, 1);
+        if (published != 1) {
+            exit_status = published == -1 ? -1 : 1;
+            break;
         }
     }
 
-    free(solution_edges->content);
-    free(solution_edges);
-    return 1;
+    free(solution);
+    free(sample);
+    localSearchFree(&ls);
+    return exit_status;
+}
+
+/**
+ * exact engine
+ * @brief runs the branch and bound search with the current bound and publishes every
+ * coloring it finds below the bound. The bound is refreshed between rounds of nodes, so
+ * solutions of other generators cut off the search as well. The first worker that sees
+ * the exhausted search tells the supervisor that the bound is optimal.
+ * @param *worker - pointer to the worker
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int runExact(Worker *worker) {
+    ExactSearch es;
+    if (exactSearchInit(&es, worker->pool, worker->index) == -1) {
+        fprintf(stderr, "%s: Couldn't initialize exact search.\n", program_name);
+        return -1;
+    }
+
+    int capacity = worker->ring->shm->solutionSize;
+    Edge *solution = malloc(capacity * sizeof(Edge));
+    if (solution == NULL) {
+        exactSearchFree(&es);
+        return -1;
+    }
+
+    int exit_status = 1;
+    while (1) {
+        int bound = currentBound(worker);
+        if (bound < es.bound) {
+            es.bound = bound;
+        }
+
+        long nodes = es.nodes;
+        int result = exactSearchRun(&es, 4096);
+        recordAttempts(worker, es.nodes - nodes);
+
+        if (result == EXACT_RUNNING) {
+            if (isTerminated(worker->ring)) {
+                break;
+            }
+        } else if (result == EXACT_FOUND) {
+            int length = exactSearchSolution(&es, solution, capacity);
+            int published = publishSolutions(worker, solution, &length, 1);
+            if (published != 1) {
+                exit_status = published == -1 ? -1 : 1;
+                break;
+            }
+        } else {
+            if (result == EXACT_DONE && exactPoolReport(worker->pool)
+                && publishProven(worker, currentBound(worker)) == -1) {
+                exit_status = -1;
+            }
+            break;
+        }
+    }
+
+    free(solution);
+    exactSearchFree(&es);
+    return exit_status;
+}
+
+/**
+ * entry point of a worker thread
+ * @brief pins the thread if requested and runs the selected engine. The worker gives its
+ * counters back when the engine returns.
+ * @param *arg - pointer to the worker
+ * @return NULL, the result is stored in the status of the worker
+ **/
+static void *runWorker(void *arg) {
+    Worker *worker = arg;
+
+    if (worker->cpu >= 0 && pinToCpu(worker->cpu) == -1) {
+        fprintf(stderr, "%s: Couldn't pin worker to processor %d.\n", program_name, worker->cpu);
+    }
+
+    if (worker->engine == ENGINE_LOCAL) {
+        worker->status = runLocalSearch(worker);
+    } else if (worker->engine == ENGINE_EXACT) {
+        worker->status = runExact(worker);
+    } else {
+        worker->status = runRandom(worker);
+    }
+
+    // a worker that still holds claimed slots leaves the block to the supervisor, which
+    // publishes them when it reaps the process
+    if (__atomic_load_n(&worker->stats->claim.count, __ATOMIC_ACQUIRE) == 0) {
+        __atomic_store_n(&worker->stats->owner, 0, __ATOMIC_RELEASE);
+    }
+    return NULL;
 }
 
 /**
  * handles new solutions
- * @brief opens all semaphores and shared memory, calls generate and adds solution to circular buffer
- * @param edge_array - pointer to given edges, forwarded to generate methode
+ * @brief opens the shared memory and starts the worker threads. Every worker
+ * takes the next random number stream from the supervisor and a free block of counters,
+ * at most STATS_SIZE workers of all generators run at once, all workers share the graph.
+ * Without a graph of its own the generator maps the next part of the graph of the supervisor.
+ * The shared memory object is mapped with the size the supervisor gave it, ring size,
+ * solution size and spin are read from its header.
+ * @param *graph - pointer to the graph, forwarded to the engine, its memory is NULL if
+ * the graph of the supervisor is used
+ * @param engine - ENGINE_RANDOM, ENGINE_LOCAL or ENGINE_EXACT
+ * @param batch - maximum number of slots claimed and published at once by the random engine,
+ * at most the ring size
+ * @param *seed - seed given on the command line, NULL to use the seed of the supervisor
+ * @param threads - number of worker threads
+ * @param pin - integer 1 if every worker is pinned to the allowed processor of its stream
+ * @param islands - integer 1 if local search workers on a part of the graph of the supervisor
+ * exchange colorings through the elite pool
  * @return integer 1 if success, integer -1 if failure
  **/
-static int handleSolutions(EdgeArray *edge_array) {
+static int handleSolutions(Graph *graph, int engine, int batch, const uint64_t *seed, int threads, int pin, int islands) {
+
+    char shm_name[INSTANCE_NAME_SIZE];
+    char graph_name[INSTANCE_NAME_SIZE];
+    char elite_name[INSTANCE_NAME_SIZE];
+    if (instanceName(shm_name, SHM) == -1 || instanceName(graph_name, SHM_GRAPH) == -1
+        || instanceName(elite_name, SHM_ELITE) == -1) {
+        fprintf(stderr, "%s: Invalid instance in %s.\n", program_name, INSTANCE_ENV);
+        return -1;
+    }
 
     int openErrCode = 1;
-    int shmfd = shm_open(SHM, O_RDWR, 0600);
+    int shmfd = shm_open(shm_name, O_RDWR, 0600);
     if (shmfd == -1) { openErrCode = -1; }
 
+    struct stat shm_stat;
+    size_t shm_size = sizeof(ShmObj);
+    if (shmfd != -1 && fstat(shmfd, &shm_stat) == 0 && (size_t) shm_stat.st_size > shm_size) {
+        shm_size = shm_stat.st_size;
+    }
+
     ShmObj *shm_obj;
-    shm_obj = mmap(NULL, sizeof(*shm_obj), PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+    shm_obj = mmap(NULL, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
 
     if (shm_obj == MAP_FAILED) {
         close(shmfd);
-        shm_unlink(SHM);
+        shm_unlink(shm_name);
         openErrCode = -1;
     }
 
     if (close(shmfd) == -1) {
-        munmap(shm_obj, sizeof(*shm_obj));
-        shm_unlink(SHM);
+        munmap(shm_obj, shm_size);
+        shm_unlink(shm_name);
         openErrCode = -1;
     }
 
-    sem_t *s_free = sem_open(SEM_FREE, 0);
-    if (s_free == SEM_FAILED) {
-        munmap(shm_obj, sizeof(*shm_obj));
-        shm_unlink(SHM);
-        openErrCode = -1;
+    if (openErrCode == 1) {
+        ringAdvise(shm_obj, shm_size);
     }
 
-    sem_t *s_used = sem_open(SEM_USED, 0);
-    if (s_used == SEM_FAILED) {
-        munmap(shm_obj, sizeof(*shm_obj));
-        shm_unlink(SHM);
-        sem_close(s_free);
-        sem_unlink(SEM_FREE);
-        openErrCode = -1;
+    if ( openErrCode != 1 ) {
+        fprintf(stderr, "%s: Couldn't open shared memory.\n", program_name);
+        return openErrCode;
     }
 
-    sem_t *s_write = sem_open(SEM_WRITE, 0);
-    if (s_write == SEM_FAILED) {
-        munmap(shm_obj, sizeof(*shm_obj));
-        shm_unlink(SHM);
-        sem_close(s_free);
-        sem_unlink(SEM_FREE);
-        sem_close(s_used);
-        sem_unlink(SEM_USED);
-        openErrCode = -1;
+    // the supervisor writes the size after the rest of the header
+    if (__atomic_load_n(&shm_obj->size, __ATOMIC_ACQUIRE) != shm_size) {
+        fprintf(stderr, "%s: Shared memory is not initialized by the supervisor.\n", program_name);
+        munmap(shm_obj, shm_size);
+        return -1;
     }
 
-    if ( openErrCode != 1 ) {
-        fprintf(stderr, "%s: Couldn't open semaphores or shared memory.\n", program_name);
-        return openErrCode;
+    if (graph->memory == NULL) {
+        int part = __atomic_fetch_add(&shm_obj->nextPart, 1, __ATOMIC_RELAXED);
+        if (graphAttachShared(graph, graph_name, part) == -1) {
+            fprintf(stderr, "%s: No edges given and supervisor has no graph.\n", program_name);
+            munmap(shm_obj, shm_size);
+            return -1;
+        }
+    }
+
+    // without the pool the workers restart from random colorings as before
+    ElitePool elite;
+    ElitePool *elite_pool = NULL;
+    if (engine == ENGINE_LOCAL && islands && graph->part >= 0
+        && eliteAttachShared(&elite, elite_name, graph->part, graph->vertices) == 1) {
+        elite_pool = &elite;
     }
 
+    Ring ring = { shm_obj, shm_obj->spin };
     int exit_status = 1;
+    int best = shm_obj->solutionSize + 1;
+    if (batch > shm_obj->ringSize) {
+        batch = shm_obj->ringSize;
+    }
 
-    while (1) {
-        if (sem_wait(s_write) == -1) {
-            if (errno == EINTR) {
-                continue;
-            }
+    Worker *workers = calloc(threads, sizeof(Worker));
+    if (workers == NULL) {
+        exit_status = -1;
+        threads = 0;
+    }
+
+    ExactPool pool;
+    if (engine == ENGINE_EXACT && threads > 0 && exactPoolInit(&pool, graph, shm_obj->colorCount, threads, &shm_obj->terminate) == -1) {
+        fprintf(stderr, "%s: Couldn't initialize exact search.\n", program_name);
+        exit_status = -1;
+        threads = 0;
+    }
+
+    // the streams of all generators of the run are distinct, so pinned workers of different
+    // generators spread over the allowed processors instead of all taking the first ones
+    int allowed = pin ? allowedCpus() : -1;
+    if (pin && allowed != -1 && allowed < threads) {
+        fprintf(stderr, "%s: %d worker(s) share %d allowed processor(s).\n", program_name, (int) threads, allowed);
+    }
+
+    int started = 0;
+    for (int i = 0; i < threads; i++) {
+        workers[i].ring = &ring;
+        workers[i].graph = graph;
+        workers[i].engine = engine;
+        workers[i].batch = batch;
+        workers[i].seed = seed != NULL ? *seed : shm_obj->seed;
+        workers[i].stream = __atomic_fetch_add(&shm_obj->nextStream, 1, __ATOMIC_RELAXED);
+        workers[i].cpu = pin ? (int) (workers[i].stream % INT_MAX) : -1;
+        workers[i].best = &best;
+        workers[i].stats = takeStats(shm_obj, workers[i].stream);
+        workers[i].pool = &pool;
+        workers[i].elite = elite_pool;
+        workers[i].index = i;
+
+        // without counters the supervisor could not recover the slots of the worker
+        if (workers[i].stats == NULL) {
+            fprintf(stderr, "%s: No free counters for worker thread %d, running with %d.\n", program_name, i, started);
             exit_status = -1;
             break;
         }
-
-        if (sem_wait(s_free) == -1) {
-            if (errno == EINTR) {
-                continue;
-            }
+        if (pthread_create(&workers[i].thread, NULL, runWorker, &workers[i]) != 0) {
+            fprintf(stderr, "%s: Couldn't start worker thread %d, running with %d.\n", program_name, i, started);
+            __atomic_store_n(&workers[i].stats->owner, 0, __ATOMIC_RELEASE);
             exit_status = -1;
             break;
         }
+        started++;
+    }
 
-        if (shm_obj->terminate == 1) {
-            fprintf(stderr, "%s: Supervisor terminates %s.\n", program_name, program_name);
-            sem_post(s_write);
-            sem_post(s_free);
-            break;
-        }
+    // the exact search is exhausted when all started workers are idle
+    if (engine == ENGINE_EXACT && threads > 0) {
+        __atomic_store_n(&pool.workers, started, __ATOMIC_RELEASE);
+    }
 
-        if ( generate(edge_array, shm_obj) == -1) {
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+        if (workers[i].status == -1) {
             exit_status = -1;
-            break;
         }
-
-        shm_obj->writePos = (shm_obj->writePos + 1) % 50;
-        sem_post(s_used);
-        sem_post(s_write);
     }
+    free(workers);
 
-    if (sem_close(s_free) == -1) {
-        exit_status = -1;
-    }
-    if (sem_close(s_used) == -1) {
-        exit_status = -1;
-    }
-    if (sem_close(s_write) == -1) {
-        exit_status = -1;
+    if (engine == ENGINE_EXACT && threads > 0) {
+        __atomic_store_n(&pool.workers, threads, __ATOMIC_RELAXED);
+        exactPoolFree(&pool);
     }
 
-    if (sem_unlink(SEM_FREE) == -1) {
-        exit_status = -1;
-    }
-    if (sem_unlink(SEM_USED) == -1) {
-        exit_status = -1;
-    }
-    if (sem_unlink(SEM_WRITE) == -1) {
-        exit_status = -1;
+    if (elite_pool != NULL) {
+        eliteClose(elite_pool);
     }
 
-    if (munmap(shm_obj, sizeof(*shm_obj)) == -1) {
-        exit_status = -1;
+    if (isTerminated(&ring)) {
+        fprintf(stderr, "%s: Supervisor terminates %s.\n", program_name, program_name);
     }
 
-    if (shm_unlink(SHM) == -1) {
+    // the supervisor unlinks the shared memory, generators that end before the run
+    // only unmap it so that restarted and late generators still find it
+    if (munmap(shm_obj, shm_size) == -1) {
         exit_status = -1;
     }
 
@@ -252,48 +685,112 @@ static int handleSolutions(EdgeArray *edge_array) {
 /**
  * Program entry point.
  * @brief The program starts here. This function takes care about input arguments.
- * All Edges are added to the EdgeArray. The EdgeArray is than passed to the handleSolutions Function.
+ * -e selects the engine, random colorings (default), local search or exact search. The
+ * workers of an exact generator split one search tree, one exact generator per run is enough.
+ * Local search generators on the graph of the supervisor exchange good colorings through
+ * the elite pool of their part, -i lets them restart from random colorings only.
+ * -b sets the number of solutions that are claimed and published at once, default 1,
+ * at most the ring size of the supervisor.
+ * -s overrides the seed of the supervisor, the random number stream is still assigned by the supervisor.
+ * -t sets the number of worker threads, default 1, -p pins every worker to one of the processors
+ * the generator may run on, the one with the index of its stream modulo their number. Workers
+ * of different generators take different processors as long as there are enough. A generator
+ * started by supervisor -j is already restricted to one processor, all its workers share it
+ * with or without -p, so there a generator per processor with one thread each spreads best.
+ * -I selects the instance of the supervisor, by default it is taken from INSTANCE_ENV.
+ * All Edges are added to the EdgeArray and a graph is built from it. Without edges the
+ * next part of the graph of the supervisor is mapped by the handleSolutions Function.
  * @param argc The argument counter.
  * @param argv The argument vector.
  * @return Returns EXIT_SUCCESS or EXIT_FAILURE
  **/
 int main(int argc, char *argv[]) {
     program_name = argv[0];
-    if (argc <= 1) { printUsageError(); }
-
-    EdgeArray *edge_array = (EdgeArray *) malloc(sizeof(EdgeArray));
-    edge_array->content = (Edge *) malloc(sizeof(Edge));
-    edge_array->length = 0;
 
-    int current_arg;
-    for (current_arg = 1; current_arg < argc; current_arg++) {
-
-        Edge new_edge;
-
-        int tmp_from, tmp_to, sscanf_err;
-        sscanf_err = sscanf(argv[current_arg], "%d-%d", &tmp_from, &tmp_to);
-
-        if (sscanf_err == 0) {
-            fprintf (stderr, "%s: Given Edge couldn't be parsed.\n", program_name);
-            free(edge_array);
-            exit(EXIT_FAILURE);
+    long batch = 1;
+    int engine = ENGINE_RANDOM;
+    uint64_t seed;
+    uint64_t *seed_option = NULL;
+    long threads = 1;
+    int pin = 0;
+    int islands = 1;
+    char *endptr;
+    int option;
+    while ((option = getopt(argc, argv, "e:b:s:t:piI:")) != -1) {
+        switch (option) {
+            case 'I':
+                if (instanceSet(optarg) == -1) { printUsageError(); }
+                break;
+            case 'i':
+                islands = 0;
+                break;
+            case 't':
+                threads = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || threads <= 0 || threads > 1024) { printUsageError(); }
+                break;
+            case 'p':
+                pin = 1;
+                break;
+            case 'e':
+                if (strcmp(optarg, "random") == 0) {
+                    engine = ENGINE_RANDOM;
+                } else if (strcmp(optarg, "local") == 0) {
+                    engine = ENGINE_LOCAL;
+                } else if (strcmp(optarg, "exact") == 0) {
+                    engine = ENGINE_EXACT;
+                } else {
+                    printUsageError();
+                }
+                break;
+            case 'b':
+                batch = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || batch <= 0 || batch > RING_MAX_SIZE) { printUsageError(); }
+                break;
+            case 's':
+                errno = 0;
+                seed = strtoull(optarg, &endptr, 10);
+                if (*endptr != '\0' || *optarg == '\0' || errno != 0) { printUsageError(); }
+                seed_option = &seed;
+                break;
+            default:
+                printUsageError();
         }
+    }
 
-        new_edge.from = tmp_from;
-        new_edge.to = tmp_to;
-
+    Graph graph;
+    graph.memory = NULL;
+    if (optind != argc) {
+        EdgeArray *edge_array = (EdgeArray *) malloc(sizeof(EdgeArray));
+        edge_array->content = (Edge *) malloc((argc - optind) * sizeof(Edge));
+        edge_array->length = 0;
+
+        int current_arg;
+        for (current_arg = optind; current_arg < argc; current_arg++) {
+
+            if (graphParseEdge(argv[current_arg], &edge_array->content[edge_array->length]) == -1) {
+                fprintf (stderr, "%s: Given Edge couldn't be parsed.\n", program_name);
+                free(edge_array->content);
+                free(edge_array);
+                exit(EXIT_FAILURE);
+            }
+            edge_array->length++;
+        }
 
-        if (addToArray(edge_array, new_edge) == -1) {
-            free(edge_array);
+        int created = graphCreateLocal(&graph, edge_array->content, edge_array->length);
+        free(edge_array->content);
+        free(edge_array);
+        if (created == -1) {
             exit(EXIT_FAILURE);
         }
     }
 
-    if (handleSolutions(edge_array) == -1) {
-        free(edge_array);
+    int handled = handleSolutions(&graph, engine, batch, seed_option, threads, pin, islands);
+    if (graph.memory != NULL) {
+        graphClose(&graph);
+    }
+    if (handled == -1) {
         exit(EXIT_FAILURE);
     }
 
-    free(edge_array);
     exit(EXIT_SUCCESS);
 }
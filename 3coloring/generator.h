@@ -3,19 +3,69 @@
  * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
  * @date 21.11.2020
  *
- * @brief Contains structs for generator.c
+ * @brief Contains definitions for generator.c
  *
  **/
 
 #ifndef GENERATOR_H
 #define GENERATOR_H
 
-// Defines an array of edges, length indicates the current size of the array
-struct EdgeArray {
-    int length;
-    Edge *content;
+#include <pthread.h>
+
+#include "ring.h"
+#include "graph.h"
+#include "exactsearch.h"
+#include "elite.h"
+
+/**
+ * engine that colors every vertex randomly for every solution
+ * */
+#define ENGINE_RANDOM 0
+
+/**
+ * engine that improves one coloring by min-conflicts tabu search
+ * */
+#define ENGINE_LOCAL 1
+
+/**
+ * engine that searches all colorings by branch and bound and proves the optimum
+ * */
+#define ENGINE_EXACT 2
+
+/**
+ * attempts after which the random engine publishes a batch that is not full yet
+ * */
+#define RANDOM_FLUSH_ATTEMPTS 65536
+
+// State of one worker thread of the generator
+// ring, graph, engine and batch are the same for all workers of the process
+// best points to the smallest number of edges published by any worker of the process,
+// workers only publish solutions that lower it
+// stream is the random number stream of the worker, cpu is the index of the processor
+// among the allowed ones it is pinned to or -1, status is the result of the worker
+// stats are the counters of the worker in the shared memory object, the worker holds
+// them while it runs
+// pool is the search tree shared by the workers of the exact engine, index is the
+// index of the worker in it
+// elite is the pool of good colorings of the graph part that local search workers
+// exchange with the other generators, NULL if the generator searches on its own
+struct Worker {
+    Ring *ring;
+    const Graph *graph;
+    int engine;
+    int batch;
+    uint64_t seed;
+    uint64_t stream;
+    int cpu;
+    int *best;
+    Stats *stats;
+    ExactPool *pool;
+    ElitePool *elite;
+    int index;
+    int status;
+    pthread_t thread;
 };
-typedef struct EdgeArray EdgeArray;
+typedef struct Worker Worker;
 
 #endif
 
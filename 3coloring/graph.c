@@ -0,0 +1,338 @@
+/**
+ * @file graph.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Graph module. Reads edges and builds a compressed sparse row representation
+ * of the graph in one block of memory. The supervisor builds the parts of its graph once
+ * in a read only shared memory object, generators map it without copying.
+ *
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#include "graph.h"
+
+/**
+ * parses one vertex index
+ * @param *text - the index as text
+ * @param **end - the first character after the index is written to it
+ * @return the index, integer -1 if the text starts with no index up to GRAPH_MAX_VERTEX
+ **/
+static int parseVertex(const char *text, const char **end) {
+    long value = 0;
+    const char *c = text;
+    while (*c >= '0' && *c <= '9') {
+        value = value * 10 + (*c - '0');
+        if (value > GRAPH_MAX_VERTEX) {
+            return -1;
+        }
+        c++;
+    }
+    *end = c;
+    return c == text ? -1 : (int) value;
+}
+
+/**
+ * parses one edge
+ * @brief the edge is given as FROM-TO with two vertex indices from 0 to GRAPH_MAX_VERTEX
+ * @param *text - the edge as text
+ * @param *edge - the parsed edge is written to it
+ * @return integer 1 if success, integer -1 if the text is no valid edge
+ **/
+int graphParseEdge(const char *text, Edge *edge) {
+    const char *end;
+    edge->from = parseVertex(text, &end);
+    if (edge->from == -1 || *end != '-') {
+        return -1;
+    }
+    edge->to = parseVertex(end + 1, &end);
+    if (edge->to == -1 || *end != '\0') {
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * reads edges from a file
+ * @brief edges are given as FROM-TO separated by whitespace, at most GRAPH_MAX_EDGES.
+ * The array grows by doubling its capacity, the content has to be freed by the caller.
+ * @param *file - the file which is read from
+ * @param *edges - pointer to an empty edge array
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int graphRead(FILE *file, EdgeArray *edges) {
+    int capacity = 0;
+    char text[64];
+
+    edges->length = 0;
+    edges->content = NULL;
+
+    while (fscanf(file, "%63s", text) == 1) {
+        if (edges->length == GRAPH_MAX_EDGES) {
+            return -1;
+        }
+        if (edges->length == capacity) {
+            capacity = capacity == 0 ? 1024 : capacity * 2;
+            Edge *content = realloc(edges->content, (size_t) capacity * sizeof(Edge));
+            if (content == NULL) {
+                return -1;
+            }
+            edges->content = content;
+        }
+
+        if (graphParseEdge(text, &edges->content[edges->length]) == -1) {
+            return -1;
+        }
+        edges->length++;
+    }
+
+    if (ferror(file)) {
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * calculates the layout of a graph
+ * @brief the number of vertices is the largest vertex index plus one, the indices are at
+ * most GRAPH_MAX_VERTEX and there are at most GRAPH_MAX_EDGES edges, so the counts fit into
+ * an int and the size is calculated in size_t
+ * @param *header - vertices, length, self loops and length of the adjacency array are written to it
+ * @param *edges - the edges of the graph
+ * @param length - number of edges
+ * @return number of bytes of the graph in memory
+ **/
+static size_t graphLayout(GraphHeader *header, const Edge *edges, int length) {
+    memset(header, 0, sizeof(*header));
+    header->length = length;
+
+    for (int i = 0; i < length; i++) {
+        if (edges[i].from >= header->vertices) { header->vertices = edges[i].from + 1; }
+        if (edges[i].to >= header->vertices) { header->vertices = edges[i].to + 1; }
+        if (edges[i].from == edges[i].to) { header->selfLoops++; }
+    }
+    header->adjacentLength = 2 * (length - header->selfLoops);
+
+    return sizeof(GraphHeader)
+           + ((size_t) header->vertices + 1 + (size_t) header->adjacentLength + 2 * (size_t) length) * sizeof(int);
+}
+
+/**
+ * sets the pointers of a graph view
+ * @param *graph - the graph view
+ * @param *memory - memory that starts with a graph header
+ * @param size - size of the memory
+ **/
+static void graphView(Graph *graph, void *memory, size_t size) {
+    GraphHeader *header = memory;
+    int *offsets = (int *) (header + 1);
+
+    graph->vertices = header->vertices;
+    graph->length = header->length;
+    graph->selfLoops = header->selfLoops;
+    graph->offsets = offsets;
+    graph->adjacent = offsets + header->vertices + 1;
+    graph->from = graph->adjacent + header->adjacentLength;
+    graph->to = graph->from + header->length;
+    graph->memory = memory;
+    graph->size = size;
+}
+
+/**
+ * builds a graph in memory
+ * @brief writes the header, counts the degrees into the offsets, sums them up and
+ * fills the neighbours of every vertex
+ * @param *memory - memory of the size calculated by graphLayout
+ * @param *header - layout calculated by graphLayout
+ * @param *edges - the edges of the graph
+ * @param length - number of edges
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int graphBuild(void *memory, const GraphHeader *header, const Edge *edges, int length) {
+    int *fill = malloc((header->vertices + 1) * sizeof(int));
+    if (fill == NULL) {
+        return -1;
+    }
+
+    memcpy(memory, header, sizeof(*header));
+
+    int *offsets = (int *) ((GraphHeader *) memory + 1);
+    int *adjacent = offsets + header->vertices + 1;
+    int *from = adjacent + header->adjacentLength;
+    int *to = from + length;
+
+    memset(offsets, 0, (header->vertices + 1) * sizeof(int));
+    for (int i = 0; i < length; i++) {
+        if (edges[i].from != edges[i].to) {
+            offsets[edges[i].from + 1]++;
+            offsets[edges[i].to + 1]++;
+        }
+    }
+    for (int v = 0; v < header->vertices; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    memcpy(fill, offsets, header->vertices * sizeof(int));
+    for (int i = 0; i < length; i++) {
+        if (edges[i].from != edges[i].to) {
+            adjacent[fill[edges[i].from]++] = edges[i].to;
+            adjacent[fill[edges[i].to]++] = edges[i].from;
+        }
+    }
+
+    for (int i = 0; i < length; i++) {
+        from[i] = edges[i].from;
+        to[i] = edges[i].to;
+    }
+    free(fill);
+    return 1;
+}
+
+/**
+ * builds a graph in private memory
+ * @param *graph - the graph view
+ * @param *edges - the edges of the graph
+ * @param length - number of edges
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int graphCreateLocal(Graph *graph, const Edge *edges, int length) {
+    GraphHeader header;
+    size_t size = graphLayout(&header, edges, length);
+
+    void *memory = malloc(size);
+    if (memory == NULL) {
+        return -1;
+    }
+
+    if (graphBuild(memory, &header, edges, length) == -1) {
+        free(memory);
+        return -1;
+    }
+    graphView(graph, memory, size);
+    graph->shared = 0;
+    graph->part = -1;
+    return 1;
+}
+
+/**
+ * builds the parts of a graph in the shared memory object of the graph
+ * @brief the shared memory is created, filled and then made read only for its owner, so
+ * it can no longer be opened for writing, generators map it read only. Every part starts
+ * on a cache line.
+ * @param *name - name of the shared memory object
+ * @param *parts - the edges of every part
+ * @param count - number of parts, at most MAX_PARTS
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int graphCreateShared(const char *name, const EdgeArray *parts, int count) {
+    GraphSetHeader set;
+    GraphHeader headers[MAX_PARTS];
+    memset(&set, 0, sizeof(set));
+    set.parts = count;
+
+    size_t size = (sizeof(GraphSetHeader) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    for (int i = 0; i < count; i++) {
+        set.offsets[i] = size;
+        size += graphLayout(&headers[i], parts[i].content, parts[i].length);
+        size = (size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    }
+
+    int shmfd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (shmfd == -1) {
+        return -1;
+    }
+
+    if (ftruncate(shmfd, size) < 0) {
+        close(shmfd);
+        shm_unlink(name);
+        return -1;
+    }
+
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+    if (memory == MAP_FAILED) {
+        close(shmfd);
+        shm_unlink(name);
+        return -1;
+    }
+
+    memcpy(memory, &set, sizeof(set));
+    for (int i = 0; i < count; i++) {
+        void *part = (unsigned char *) memory + set.offsets[i];
+        if (graphBuild(part, &headers[i], parts[i].content, parts[i].length) == -1) {
+            munmap(memory, size);
+            close(shmfd);
+            shm_unlink(name);
+            return -1;
+        }
+    }
+
+    // the supervisor keeps no mapping, the generators only get read access
+    munmap(memory, size);
+    if (fchmod(shmfd, 0400) == -1) {
+        close(shmfd);
+        shm_unlink(name);
+        return -1;
+    }
+    close(shmfd);
+    return 1;
+}
+
+/**
+ * maps one part of the graph of the supervisor
+ * @brief the whole shared memory object is mapped, the view points to the part
+ * @param *graph - the graph view
+ * @param *name - name of the shared memory object
+ * @param part - index of the part, it is taken modulo the number of parts
+ * @return integer 1 if success, integer -1 if failure or if the graph has no parts
+ **/
+int graphAttachShared(Graph *graph, const char *name, int part) {
+    int shmfd = shm_open(name, O_RDONLY, 0);
+    if (shmfd == -1) {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(shmfd, &st) == -1 || st.st_size < (off_t) sizeof(GraphSetHeader)) {
+        close(shmfd);
+        return -1;
+    }
+
+    void *memory = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, shmfd, 0);
+    close(shmfd);
+    if (memory == MAP_FAILED) {
+        return -1;
+    }
+
+    const GraphSetHeader *set = memory;
+    if (set->parts <= 0 || set->parts > MAX_PARTS) {
+        munmap(memory, st.st_size);
+        return -1;
+    }
+    part %= set->parts;
+
+    graphView(graph, (unsigned char *) memory + set->offsets[part], st.st_size);
+    graph->memory = memory;
+    graph->shared = 1;
+    graph->part = part;
+    return 1;
+}
+
+/**
+ * releases the memory of a graph
+ * @brief shared graphs are unmapped, the supervisor unlinks the shared memory object itself
+ * @param *graph - the graph view
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int graphClose(Graph *graph) {
+    if (graph->shared) {
+        return munmap(graph->memory, graph->size) == -1 ? -1 : 1;
+    }
+    free(graph->memory);
+    return 1;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file graph.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Contains structs for graph.c
+ *
+ **/
+
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "structs.h"
+
+/**
+ * largest vertex index of a graph, larger indices are parse errors, so the number of
+ * vertices and the size of the graph in memory never overflow
+ * */
+#define GRAPH_MAX_VERTEX ((1 << 24) - 1)
+
+/**
+ * maximum number of edges of a graph file, twice the number fits into the offsets
+ * */
+#define GRAPH_MAX_EDGES (1 << 28)
+
+// Header of a graph in memory, it is followed by int offsets[vertices + 1],
+// int adjacent[adjacentLength], int from[length] and int to[length]
+// self loops are only contained in from and to, no coloring removes them
+struct GraphHeader {
+    int vertices;
+    int length;
+    int selfLoops;
+    int adjacentLength;
+};
+typedef struct GraphHeader GraphHeader;
+
+// Header of the shared memory object of the graph, it holds the parts of the graph of
+// the supervisor, part i starts with its graph header offsets[i] bytes after the start
+struct GraphSetHeader {
+    int parts;
+    size_t offsets[MAX_PARTS];
+};
+typedef struct GraphSetHeader GraphSetHeader;
+
+// Compressed sparse row view of a graph
+// neighbours of v are adjacent[offsets[v]] ... adjacent[offsets[v + 1] - 1]
+// from and to contain all edges in the given order, edge i goes from from[i] to to[i],
+// separate arrays let the conflict kernel load eight edges with two vector loads
+// memory and size describe the memory that holds the graph, shared is 1 if it is
+// the mapped shared memory of the supervisor
+// part is the part of the graph of the supervisor, -1 for a graph given to the generator
+struct Graph {
+    int vertices;
+    int length;
+    int selfLoops;
+    const int *offsets;
+    const int *adjacent;
+    const int *from;
+    const int *to;
+    void *memory;
+    size_t size;
+    int shared;
+    int part;
+};
+typedef struct Graph Graph;
+
+int graphParseEdge(const char *text, Edge *edge);
+int graphRead(FILE *file, EdgeArray *edges);
+int graphCreateLocal(Graph *graph, const Edge *edges, int length);
+int graphCreateShared(const char *name, const EdgeArray *parts, int count);
+int graphAttachShared(Graph *graph, const char *name, int part);
+int graphClose(Graph *graph);
+
+#endif
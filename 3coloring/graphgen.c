@@ -0,0 +1,160 @@
+/**
+ * @file graphgen.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Graph synthesizer for the benchmarks. Writes a random graph as one edge per
+ * line to stdout, the format the supervisor reads with -g.
+ * gnp is the random graph G(n,p), every pair of vertices is an edge with probability p.
+ * planted colors the vertices randomly with three colors and keeps only edges between
+ * different colors, so the graph is 3-colorable and the best solution has 0 edges.
+ * dense is a planted graph with high p and a few edges inside the color classes,
+ * so only a handful of edges have to be removed to make it 3-colorable.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "rng.h"
+
+/**
+ * Pointer to name of program
+ **/
+static char *program_name;
+
+/**
+ * printUsageError function.
+ * @brief Usage of program is printed to stderr and program is exited with failure code
+ * @details global variables: program_name, contains the name of the program
+ **/
+static void printUsageError(void) {
+
+    fprintf(stderr, "Usage: %s [-t gnp|planted|dense] [-n VERTICES] [-p PROBABILITY] [-s SEED]\n", program_name);
+    exit(EXIT_FAILURE);
+
+}
+
+/**
+ * returns a random number between 0 and 1
+ * @param *rng - pointer to the generator
+ * @return uniformly distributed number in [0, 1)
+ **/
+static double uniform(Rng *rng) {
+    return (rngNext(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * writes random edges
+ * @brief every pair of vertices with different colors is an edge with probability p,
+ * a NULL coloring counts as all vertices having different colors
+ * @param *rng - pointer to the generator
+ * @param vertices - number of vertices
+ * @param probability - probability of an edge
+ * @param *colors - color of every vertex or NULL
+ **/
+static void writeEdges(Rng *rng, int vertices, double probability, const uint8_t *colors) {
+    for (int from = 0; from < vertices; from++) {
+        for (int to = from + 1; to < vertices; to++) {
+            if (colors != NULL && colors[from] == colors[to]) {
+                continue;
+            }
+            if (uniform(rng) < probability) {
+                fprintf(stdout, "%d-%d\n", from, to);
+            }
+        }
+    }
+}
+
+/**
+ * Program entry point.
+ * @brief The program starts here. -t selects the kind of graph, default gnp.
+ * -n sets the number of vertices, default 500. -p sets the probability of an edge,
+ * default 0.01 for gnp, 0.02 for planted and 0.5 for dense. -s sets the seed, default 1.
+ * @param argc The argument counter.
+ * @param argv The argument vector.
+ * @return Returns EXIT_SUCCESS or EXIT_FAILURE
+ **/
+int main(int argc, char *argv[]) {
+    program_name = argv[0];
+
+    const char *type = "gnp";
+    long vertices = 500;
+    double probability = -1;
+    uint64_t seed = 1;
+    char *endptr;
+
+    int option;
+    while ((option = getopt(argc, argv, "t:n:p:s:")) != -1) {
+        switch (option) {
+            case 't':
+                type = optarg;
+                break;
+            case 'n':
+                vertices = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || vertices < 2 || vertices > INT_MAX) { printUsageError(); }
+                break;
+            case 'p':
+                probability = strtod(optarg, &endptr);
+                if (*endptr != '\0' || !(probability > 0 && probability <= 1)) { printUsageError(); }
+                break;
+            case 's':
+                seed = strtoull(optarg, &endptr, 10);
+                if (*endptr != '\0' || *optarg == '\0') { printUsageError(); }
+                break;
+            default:
+                printUsageError();
+        }
+    }
+    if (optind != argc) { printUsageError(); }
+
+    Rng rng;
+    rngSeed(&rng, seed, 0);
+
+    if (strcmp(type, "gnp") == 0) {
+        writeEdges(&rng, vertices, probability > 0 ? probability : 0.01, NULL);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (strcmp(type, "planted") != 0 && strcmp(type, "dense") != 0) {
+        printUsageError();
+    }
+    int dense = strcmp(type, "dense") == 0;
+    if (dense && vertices < 4) {
+        printUsageError();
+    }
+
+    uint8_t *colors = malloc(vertices);
+    if (colors == NULL) {
+        fprintf(stderr, "%s: Couldn't allocate the coloring.\n", program_name);
+        exit(EXIT_FAILURE);
+    }
+    for (long i = 0; i < vertices; i++) {
+        colors[i] = rngBelow(&rng, 3);
+    }
+
+    if (probability <= 0) {
+        probability = dense ? 0.5 : 0.02;
+    }
+    writeEdges(&rng, vertices, probability, colors);
+
+    // edges inside the color classes, each of them is a likely conflict,
+    // with at least 4 vertices one class has two of them
+    if (dense) {
+        long extra = vertices / 50 > 0 ? vertices / 50 : 1;
+        while (extra > 0) {
+            int from = rngBelow(&rng, vertices);
+            int to = rngBelow(&rng, vertices);
+            if (from != to && colors[from] == colors[to]) {
+                fprintf(stdout, "%d-%d\n", from, to);
+                extra--;
+            }
+        }
+    }
+
+    free(colors);
+    exit(EXIT_SUCCESS);
+}
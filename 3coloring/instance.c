@@ -0,0 +1,70 @@
+/**
+ * @file instance.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Instance module. Every run of the supervisor and its generators belongs to an
+ * instance, the names of its shared memory objects end with the instance, so independent
+ * runs on the same host do not collide. The instance is taken from the environment, the
+ * default instance without a suffix uses the plain names.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "instance.h"
+
+/**
+ * checks an instance
+ * @param *instance - the instance
+ * @return integer 1 if it has 1 to INSTANCE_MAX_LENGTH letters, digits, '-' or '_', integer 0 otherwise
+ **/
+static int instanceValid(const char *instance) {
+    size_t length = strlen(instance);
+    if (length == 0 || length > INSTANCE_MAX_LENGTH) {
+        return 0;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (!isalnum((unsigned char) instance[i]) && instance[i] != '-' && instance[i] != '_') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * sets the instance of the process
+ * @brief the instance is written to INSTANCE_ENV, so child processes share it
+ * @param *instance - the instance
+ * @return integer 1 if success, integer -1 if the instance is invalid or failure
+ **/
+int instanceSet(const char *instance) {
+    if (!instanceValid(instance)) {
+        return -1;
+    }
+    return setenv(INSTANCE_ENV, instance, 1) == -1 ? -1 : 1;
+}
+
+/**
+ * builds the name of a shared memory object of the instance
+ * @brief the name is the base followed by '.' and the instance, or the base itself if no
+ * instance is set
+ * @param *name - buffer of INSTANCE_NAME_SIZE characters
+ * @param *base - the name of the object in the default instance
+ * @return integer 1 if success, integer -1 if the instance in the environment is invalid
+ **/
+int instanceName(char *name, const char *base) {
+    const char *instance = getenv(INSTANCE_ENV);
+    if (instance == NULL || *instance == '\0') {
+        snprintf(name, INSTANCE_NAME_SIZE, "%s", base);
+        return 1;
+    }
+    if (!instanceValid(instance)) {
+        return -1;
+    }
+    snprintf(name, INSTANCE_NAME_SIZE, "%s.%s", base, instance);
+    return 1;
+}
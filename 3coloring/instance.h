@@ -0,0 +1,37 @@
+/**
+ * @file instance.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Contains definitions for instance.c
+ *
+ **/
+
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+/**
+ * environment variable with the instance of the run, the generators started by the
+ * supervisor inherit it
+ * */
+#define INSTANCE_ENV "COLORING_INSTANCE"
+
+/**
+ * maximum number of characters of an instance
+ * */
+#define INSTANCE_MAX_LENGTH 32
+
+/**
+ * size of a buffer for a shared memory name of an instance
+ * */
+#define INSTANCE_NAME_SIZE 96
+
+/**
+ * seconds after which a shared memory object without an owner is left from a crashed run
+ * */
+#define INSTANCE_STALE_AGE 5
+
+int instanceSet(const char *instance);
+int instanceName(char *name, const char *base);
+
+#endif
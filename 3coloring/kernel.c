@@ -0,0 +1,99 @@
+/**
+ * @file kernel.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Kernel module. Counts edges between vertices of the same color. The AVX2 kernel
+ * loads eight from and eight to indices, gathers the colors of both ends and counts the
+ * equal lanes with one popcount. The kernel is chosen at runtime, so the program is built
+ * without -mavx2 and runs on every machine with the scalar kernel as fallback.
+ *
+ **/
+
+#include <stddef.h>
+
+#include "kernel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define KERNEL_AVX2
+#endif
+
+/**
+ * counts conflicts one edge after another
+ * @param *from - start vertices of the edges
+ * @param *to - end vertices of the edges
+ * @param *colors - one color per vertex
+ * @param begin - first edge
+ * @param end - one after the last edge
+ * @return number of edges between vertices of the same color
+ **/
+int countConflictsScalar(const int *from, const int *to, const uint8_t *colors, int begin, int end) {
+    int count = 0;
+    for (int i = begin; i < end; i++) {
+        count += colors[from[i]] == colors[to[i]];
+    }
+    return count;
+}
+
+#ifdef KERNEL_AVX2
+/**
+ * counts conflicts eight edges at a time
+ * @brief the gathers load four bytes at every color, the mask keeps the color byte.
+ * The remaining edges are counted by the scalar kernel.
+ * @param *from - start vertices of the edges
+ * @param *to - end vertices of the edges
+ * @param *colors - one color per vertex, followed by KERNEL_PADDING bytes
+ * @param begin - first edge
+ * @param end - one after the last edge
+ * @return number of edges between vertices of the same color
+ **/
+__attribute__((target("avx2")))
+static int countConflictsAvx2(const int *from, const int *to, const uint8_t *colors, int begin, int end) {
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    const int *base = (const int *) colors;
+    int count = 0;
+    int i = begin;
+
+    for (; i + 8 <= end; i += 8) {
+        __m256i from_index = _mm256_loadu_si256((const __m256i *) (from + i));
+        __m256i to_index = _mm256_loadu_si256((const __m256i *) (to + i));
+
+        __m256i from_color = _mm256_and_si256(_mm256_i32gather_epi32(base, from_index, 1), mask);
+        __m256i to_color = _mm256_and_si256(_mm256_i32gather_epi32(base, to_index, 1), mask);
+
+        __m256i equal = _mm256_cmpeq_epi32(from_color, to_color);
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+    }
+
+    return count + countConflictsScalar(from, to, colors, i, end);
+}
+#endif
+
+/**
+ * selects the fastest kernel of this machine
+ * @return the AVX2 kernel if the processor supports it, the scalar kernel otherwise
+ **/
+ConflictKernel kernelSelect(void) {
+#ifdef KERNEL_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return countConflictsAvx2;
+    }
+#endif
+    return countConflictsScalar;
+}
+
+/**
+ * returns the name of a kernel
+ * @param kernel - a kernel returned by kernelSelect
+ * @return name of the kernel
+ **/
+const char *kernelName(ConflictKernel kernel) {
+#ifdef KERNEL_AVX2
+    if (kernel == countConflictsAvx2) {
+        return "avx2";
+    }
+#endif
+    return "scalar";
+}
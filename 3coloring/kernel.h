@@ -0,0 +1,34 @@
+/**
+ * @file kernel.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Contains definitions for kernel.c
+ *
+ **/
+
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include <stdint.h>
+
+/**
+ * bytes that have to be allocated after the last vertex color, the vector kernel
+ * loads four bytes at the position of a color
+ * */
+#define KERNEL_PADDING 4
+
+/**
+ * number of edges the random engine counts at once before it looks at the single edges
+ * */
+#define KERNEL_BLOCK 32
+
+// Counts the edges begin ... end - 1 whose vertices have the same color,
+// edge i goes from from[i] to to[i], colors holds one byte per vertex
+typedef int (*ConflictKernel)(const int *from, const int *to, const uint8_t *colors, int begin, int end);
+
+int countConflictsScalar(const int *from, const int *to, const uint8_t *colors, int begin, int end);
+ConflictKernel kernelSelect(void);
+const char *kernelName(ConflictKernel kernel);
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * @file launcher.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Launcher module. Starts the generators as child processes of the supervisor,
+ * pins every one to its own processor and collects them when they exit. The generator
+ * binary is taken from the directory of the supervisor.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/wait.h>
+
+#include "launcher.h"
+#include "affinity.h"
+
+/**
+ * returns the time of the monotonic clock
+ * @return time in seconds
+ **/
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * initializes the launcher, no worker is started yet
+ * @param *launcher - the launcher
+ * @param *self - path of the supervisor, the generator is searched next to it
+ * @param *args - arguments of every generator
+ * @param length - number of arguments
+ * @param count - number of workers
+ * @param node - preferred NUMA node of the workers, -1 for none
+ * @param first - index of the processor of the first worker
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int launcherInit(Launcher *launcher, const char *self, char *const *args, int length, int count, int node, int first) {
+    memset(launcher, 0, sizeof(*launcher));
+    launcher->count = count;
+    launcher->node = node;
+    launcher->first = first;
+
+    // a supervisor started without a directory was found in the PATH, then the
+    // generator is taken from the working directory
+    const char *slash = strrchr(self, '/');
+    size_t directory = slash != NULL ? (size_t) (slash - self + 1) : 0;
+    char *path = malloc(directory + sizeof("./generator"));
+    launcher->argv = calloc(length + 2, sizeof(char *));
+    launcher->pids = calloc(count, sizeof(pid_t));
+    launcher->started = calloc(count, sizeof(double));
+    if (path == NULL || launcher->argv == NULL || launcher->pids == NULL || launcher->started == NULL) {
+        free(path);
+        launcherFree(launcher);
+        return -1;
+    }
+
+    if (directory > 0) {
+        memcpy(path, self, directory);
+        strcpy(path + directory, "generator");
+    } else {
+        strcpy(path, "./generator");
+    }
+    launcher->argv[0] = path;
+    for (int i = 0; i < length; i++) {
+        launcher->argv[i + 1] = args[i];
+    }
+    return 1;
+}
+
+/**
+ * releases the memory of the launcher
+ * @param *launcher - the launcher
+ **/
+void launcherFree(Launcher *launcher) {
+    if (launcher->argv != NULL) {
+        free(launcher->argv[0]);
+    }
+    free(launcher->argv);
+    free(launcher->pids);
+    free(launcher->started);
+    memset(launcher, 0, sizeof(*launcher));
+}
+
+/**
+ * starts a worker
+ * @brief the child pins itself before it executes the generator, the affinity is kept
+ * across exec
+ * @param *launcher - the launcher
+ * @param index - index of the worker
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int launcherStart(Launcher *launcher, int index) {
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t pid = fork();
+    if (pid == -1) {
+        return -1;
+    }
+
+    if (pid == 0) {
+        if (pinToCpuNear(launcher->first + index, launcher->node) == -1) {
+            fprintf(stderr, "%s: Couldn't pin generator %d.\n", launcher->argv[0], index);
+        }
+        execv(launcher->argv[0], launcher->argv);
+        fprintf(stderr, "%s: Couldn't start generator.\n", launcher->argv[0]);
+        _exit(EXIT_FAILURE);
+    }
+
+    launcher->pids[index] = pid;
+    launcher->started[index] = now();
+    return 1;
+}
+
+/**
+ * collects one exited worker without blocking
+ * @param *launcher - the launcher
+ * @param *pid - the process of the worker is written to it
+ * @param *failed - set to 1 if the worker was killed or exited with a failure, 0 otherwise
+ * @param *runtime - the seconds the worker ran are written to it
+ * @return index of the worker, integer -1 if no worker exited
+ **/
+int launcherReap(Launcher *launcher, pid_t *pid, int *failed, double *runtime) {
+    int status;
+    pid_t exited;
+    while ((exited = waitpid(-1, &status, WNOHANG)) > 0) {
+        for (int i = 0; i < launcher->count; i++) {
+            if (launcher->pids[i] == exited) {
+                launcher->pids[i] = 0;
+                *pid = exited;
+                *failed = !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS;
+                *runtime = now() - launcher->started[i];
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * waits for all workers
+ * @brief the supervisor has set the terminate flag already, workers that do not exit
+ * within LAUNCHER_STOP_TIMEOUT seconds are killed
+ * @param *launcher - the launcher
+ **/
+void launcherStop(Launcher *launcher) {
+    double deadline = now() + LAUNCHER_STOP_TIMEOUT;
+    int running = 0;
+    do {
+        running = 0;
+        pid_t pid;
+        int failed;
+        double runtime;
+        while (launcherReap(launcher, &pid, &failed, &runtime) != -1) { }
+        for (int i = 0; i < launcher->count; i++) {
+            running += launcher->pids[i] != 0;
+        }
+        if (running > 0) {
+            struct timespec pause = { 0, 10000000 };
+            nanosleep(&pause, NULL);
+        }
+    } while (running > 0 && now() < deadline);
+
+    for (int i = 0; i < launcher->count; i++) {
+        if (launcher->pids[i] != 0) {
+            kill(launcher->pids[i], SIGKILL);
+            waitpid(launcher->pids[i], NULL, 0);
+            launcher->pids[i] = 0;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+/**
+ * @file launcher.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Contains definitions for launcher.c
+ *
+ **/
+
+#ifndef LAUNCHER_H
+#define LAUNCHER_H
+
+#include <sys/types.h>
+
+/**
+ * a worker that fails sooner after its start is not restarted again
+ * */
+#define LAUNCHER_MIN_RUNTIME 1.0
+
+/**
+ * seconds the workers get to see the terminate flag before they are killed
+ * */
+#define LAUNCHER_STOP_TIMEOUT 5.0
+
+// Generator processes of the supervisor
+// argv is the command line of every generator, count the number of workers
+// pids[i] is the process of worker i, 0 if it is not running, started[i] its start time
+// node is the NUMA node of the supervisor, the workers take the processors of the node
+// first, -1 to take the processors in order, worker i gets processor first + i
+struct Launcher {
+    char **argv;
+    int count;
+    pid_t *pids;
+    double *started;
+    int node;
+    int first;
+};
+typedef struct Launcher Launcher;
+
+int launcherInit(Launcher *launcher, const char *self, char *const *args, int length, int count, int node, int first);
+void launcherFree(Launcher *launcher);
+int launcherStart(Launcher *launcher, int index);
+int launcherReap(Launcher *launcher, pid_t *pid, int *failed, double *runtime);
+void launcherStop(Launcher *launcher);
+
+#endif
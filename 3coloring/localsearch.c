@@ -0,0 +1,349 @@
+/**
+ * @file localsearch.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Local search module. Keeps a coloring and repeatedly recolors the conflicted
+ * vertex with the color that removes the most conflicts (min-conflicts, tabucol). Recently left
+ * colors are tabu for some iterations, so the search does not cycle. The number of
+ * conflicts is updated through the neighbours of the recolored vertex only, one move
+ * costs O(degree) instead of a scan over all edges.
+ * The moves are written once for any number of colors k and instantiated for 3, 4 and 8
+ * colors with k as a constant, so the compiler folds the products with k and the modulo.
+ * Every other k runs the generic instance.
+ *
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "localsearch.h"
+
+/**
+ * iterations without a new best coloring until the search restarts
+ **/
+#define RESTART_STEPS 200000
+
+/**
+ * one in PERTURB_SHARE vertices gets a random color when the search restarts from a given coloring
+ **/
+#define PERTURB_SHARE 10
+
+/**
+ * adds or removes a vertex from the list of conflicted vertices
+ * @brief the vertex is conflicted if a neighbour has the same color
+ * @param *ls - pointer to the search state
+ * @param v - the vertex
+ * @param k - number of colors
+ **/
+static inline void updateConflicted(LocalSearch *ls, int v, const int k) {
+    int is_conflicted = ls->gamma[v * k + ls->colors[v]] > 0;
+
+    if (is_conflicted && ls->position[v] == -1) {
+        ls->position[v] = ls->conflictedCount;
+        ls->conflicted[ls->conflictedCount++] = v;
+    } else if (!is_conflicted && ls->position[v] != -1) {
+        int last = ls->conflicted[--ls->conflictedCount];
+        ls->conflicted[ls->position[v]] = last;
+        ls->position[last] = ls->position[v];
+        ls->position[v] = -1;
+    }
+}
+
+/**
+ * recolors a vertex
+ * @brief updates the color counts of all neighbours, the number of conflicts and the
+ * list of conflicted vertices
+ * @param *ls - pointer to the search state
+ * @param v - the vertex
+ * @param color - the new color
+ * @param k - number of colors
+ **/
+static inline void recolor(LocalSearch *ls, int v, int color, const int k) {
+    int old = ls->colors[v];
+
+    ls->conflicts += ls->gamma[v * k + color] - ls->gamma[v * k + old];
+    ls->colors[v] = color;
+
+    const Graph *graph = ls->graph;
+    for (int i = graph->offsets[v]; i < graph->offsets[v + 1]; i++) {
+        int u = graph->adjacent[i];
+        ls->gamma[u * k + old]--;
+        ls->gamma[u * k + color]++;
+        updateConflicted(ls, u, k);
+    }
+    updateConflicted(ls, v, k);
+}
+
+/**
+ * runs moves of the search
+ * @brief every move recolors one conflicted vertex. Among all conflicted vertices and
+ * their other colors the move that removes the most conflicts and is not tabu is taken,
+ * ties are broken randomly. A tabu move is allowed if it leads to a coloring better than
+ * any of the current run (aspiration). The left color is tabu for a tenure that grows
+ * with the number of conflicted vertices.
+ * @param *ls - pointer to the search state
+ * @param steps - maximum number of moves
+ * @param k - number of colors, a constant in the instances below
+ * @return like localSearchRun
+ **/
+static inline int runMoves(LocalSearch *ls, long steps, const int k) {
+    for (long step = 0; step < steps && ls->conflictedCount > 0; step++) {
+        ls->iteration++;
+
+        int v = -1;
+        int choice = -1;
+        int choice_delta = INT_MAX;
+        int ties = 0;
+        for (int i = 0; i < ls->conflictedCount; i++) {
+            int u = ls->conflicted[i];
+            int current = ls->colors[u];
+
+            for (int c = 0; c < k; c++) {
+                if (c == current) {
+                    continue;
+                }
+
+                int delta = ls->gamma[u * k + c] - ls->gamma[u * k + current];
+                if (ls->tabu[u * k + c] > ls->iteration && ls->conflicts + delta >= ls->runBest) {
+                    continue;
+                }
+
+                if (delta < choice_delta) {
+                    v = u;
+                    choice = c;
+                    choice_delta = delta;
+                    ties = 1;
+                } else if (delta == choice_delta && rngBelow(&ls->rng, ++ties) == 0) {
+                    v = u;
+                    choice = c;
+                }
+            }
+        }
+
+        if (v == -1) {
+            v = ls->conflicted[rngBelow(&ls->rng, ls->conflictedCount)];
+            choice = (ls->colors[v] + 1 + rngBelow(&ls->rng, k - 1)) % k;
+            choice_delta = ls->gamma[v * k + choice] - ls->gamma[v * k + ls->colors[v]];
+        }
+
+        // the best coloring of the run is only copied when the run leaves it
+        if (choice_delta > 0 && !ls->runSaved) {
+            memcpy(ls->runColors, ls->colors, ls->graph->vertices * sizeof(int));
+            ls->runSaved = 1;
+        }
+
+        int old = ls->colors[v];
+        recolor(ls, v, choice, k);
+        ls->tabu[v * k + old] = ls->iteration + 7 + rngBelow(&ls->rng, 10) + ls->conflictedCount * 6 / 10;
+
+        if (ls->conflicts < ls->runBest) {
+            ls->runBest = ls->conflicts;
+            ls->runSaved = 0;
+            ls->lastImprovement = ls->iteration;
+        } else if (ls->iteration - ls->lastImprovement > RESTART_STEPS) {
+            return LOCAL_STALLED;
+        }
+
+        if (ls->conflicts < ls->best && ls->conflicts <= ls->capacity) {
+            ls->best = ls->conflicts;
+            return LOCAL_FOUND;
+        }
+    }
+
+    return LOCAL_RUNNING;
+}
+
+/**
+ * defines an instance of the moves for a fixed number of colors
+ **/
+#define LOCAL_MOVES(NAME, K) \
+    static int NAME(LocalSearch *ls, long steps) { \
+        return runMoves(ls, steps, K); \
+    }
+
+LOCAL_MOVES(runMoves3, 3)
+LOCAL_MOVES(runMoves4, 4)
+LOCAL_MOVES(runMoves8, 8)
+
+/**
+ * runs the moves for the number of colors of the search state
+ * @param *ls - pointer to the search state
+ * @param steps - maximum number of moves
+ * @return like localSearchRun
+ **/
+static int runMovesAny(LocalSearch *ls, long steps) {
+    return runMoves(ls, steps, ls->colorCount);
+}
+
+/**
+ * initializes the search
+ * @brief allocates the state for the vertices of the graph and starts with a random coloring
+ * @param *ls - pointer to the search state
+ * @param *graph - the graph, it has to stay valid until the search is freed
+ * @param colorCount - number of colors, between 2 and MAX_COLORS
+ * @param capacity - maximum number of edges of a solution
+ * @param seed - seed of the run
+ * @param stream - random number stream of this generator
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int localSearchInit(LocalSearch *ls, const Graph *graph, int colorCount, int capacity, uint64_t seed, uint64_t stream) {
+    memset(ls, 0, sizeof(*ls));
+    ls->graph = graph;
+    ls->colorCount = colorCount;
+    ls->capacity = capacity;
+    rngSeed(&ls->rng, seed, stream);
+
+    switch (colorCount) {
+        case 3:
+            ls->moves = runMoves3;
+            break;
+        case 4:
+            ls->moves = runMoves4;
+            break;
+        case 8:
+            ls->moves = runMoves8;
+            break;
+        default:
+            ls->moves = runMovesAny;
+    }
+
+    int vertices = graph->vertices;
+    ls->colors = malloc((vertices + 1) * sizeof(int));
+    ls->gamma = malloc((colorCount * vertices + 1) * sizeof(int));
+    ls->tabu = malloc((colorCount * vertices + 1) * sizeof(long));
+    ls->conflicted = malloc((vertices + 1) * sizeof(int));
+    ls->position = malloc((vertices + 1) * sizeof(int));
+    ls->runColors = malloc((vertices + 1) * sizeof(int));
+    if (ls->colors == NULL || ls->gamma == NULL || ls->tabu == NULL
+        || ls->conflicted == NULL || ls->position == NULL || ls->runColors == NULL) {
+        localSearchFree(ls);
+        return -1;
+    }
+
+    ls->best = INT_MAX;
+    localSearchRestart(ls);
+    return 1;
+}
+
+/**
+ * frees the search state
+ * @param *ls - pointer to the search state
+ **/
+void localSearchFree(LocalSearch *ls) {
+    free(ls->colors);
+    free(ls->gamma);
+    free(ls->tabu);
+    free(ls->conflicted);
+    free(ls->position);
+    free(ls->runColors);
+}
+
+/**
+ * starts a new run from the current colors
+ * @brief counts the neighbour colors, the conflicts and the conflicted vertices again
+ * and clears the tabu list
+ * @param *ls - pointer to the search state
+ **/
+static void startRun(LocalSearch *ls) {
+    const Graph *graph = ls->graph;
+    int k = ls->colorCount;
+    for (int v = 0; v < graph->vertices; v++) {
+        ls->position[v] = -1;
+    }
+    memset(ls->gamma, 0, k * graph->vertices * sizeof(int));
+    memset(ls->tabu, 0, k * graph->vertices * sizeof(long));
+
+    for (int v = 0; v < graph->vertices; v++) {
+        for (int i = graph->offsets[v]; i < graph->offsets[v + 1]; i++) {
+            ls->gamma[v * k + ls->colors[graph->adjacent[i]]]++;
+        }
+    }
+
+    int twice = 0;
+    ls->conflictedCount = 0;
+    for (int v = 0; v < graph->vertices; v++) {
+        twice += ls->gamma[v * k + ls->colors[v]];
+        updateConflicted(ls, v, k);
+    }
+
+    ls->conflicts = twice / 2 + graph->selfLoops;
+    ls->runBest = ls->conflicts;
+    ls->runSaved = 0;
+    ls->lastImprovement = ls->iteration;
+}
+
+/**
+ * restarts the search from a random coloring
+ * @brief the best number of conflicts that was returned is kept, so a restart
+ * only leads to a new solution if it gets better than all earlier ones
+ * @param *ls - pointer to the search state
+ **/
+void localSearchRestart(LocalSearch *ls) {
+    for (int v = 0; v < ls->graph->vertices; v++) {
+        ls->colors[v] = rngBelow(&ls->rng, ls->colorCount);
+    }
+    startRun(ls);
+}
+
+/**
+ * restarts the search from a given coloring
+ * @brief one in PERTURB_SHARE vertices gets a random color, so generators that restart
+ * from the same coloring take different paths
+ * @param *ls - pointer to the search state
+ * @param *colors - color of every vertex
+ **/
+void localSearchRestartFrom(LocalSearch *ls, const uint8_t *colors) {
+    for (int v = 0; v < ls->graph->vertices; v++) {
+        ls->colors[v] = rngBelow(&ls->rng, PERTURB_SHARE) == 0 ? (int) rngBelow(&ls->rng, ls->colorCount) : colors[v];
+    }
+    startRun(ls);
+}
+
+/**
+ * runs the search for a number of moves
+ * @brief the moves of the number of colors of the search are run, see runMoves
+ * @param *ls - pointer to the search state
+ * @param steps - maximum number of moves
+ * @return LOCAL_FOUND if a coloring with less conflicts than every earlier one that fits
+ * into a slot was found, LOCAL_STALLED if the run did not improve for RESTART_STEPS moves
+ * and has to be restarted by the caller, LOCAL_RUNNING otherwise
+ **/
+int localSearchRun(LocalSearch *ls, long steps) {
+    if (ls->conflicts < ls->best && ls->conflicts <= ls->capacity) {
+        ls->best = ls->conflicts;
+        return LOCAL_FOUND;
+    }
+    return ls->moves(ls, steps);
+}
+
+/**
+ * writes the current coloring as solution
+ * @brief all edges between vertices of the same color are written to the solution
+ * @param *ls - pointer to the search state
+ * @param *solution - array of capacity edges
+ * @return number of edges of the solution
+ **/
+int localSearchSolution(LocalSearch *ls, Edge *solution) {
+    int length = 0;
+    const Graph *graph = ls->graph;
+    for (int i = 0; i < graph->length && length < ls->capacity; i++) {
+        if (ls->colors[graph->from[i]] == ls->colors[graph->to[i]]) {
+            solution[length].from = graph->from[i];
+            solution[length].to = graph->to[i];
+            length++;
+        }
+    }
+    return length;
+}
+
+/**
+ * returns the best coloring of the current run
+ * @brief a stalled run has left its best coloring long ago, this one has run best conflicts
+ * @param *ls - pointer to the search state
+ * @return color of every vertex, valid until the next move
+ **/
+const int *localSearchRunColors(const LocalSearch *ls) {
+    return ls->runSaved ? ls->runColors : ls->colors;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file localsearch.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Contains structs for localsearch.c
+ *
+ **/
+
+#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+
+#include "structs.h"
+#include "graph.h"
+#include "rng.h"
+
+/**
+ * results of localSearchRun
+ * */
+#define LOCAL_RUNNING 0
+#define LOCAL_FOUND 1
+#define LOCAL_STALLED 2
+
+// State of the min-conflicts tabu search
+// graph is the searched graph, its adjacency lists are used for the updates
+// color count is the number of colors k, moves runs the moves specialized for k
+// gamma[v * k + c] is the number of neighbours of v with color c
+// tabu[v * k + c] is the iteration until which v must not get color c again
+// conflicted holds all vertices with at least one neighbour of the same color,
+// position[v] is the index of v in conflicted or -1
+// conflicts is the number of edges between vertices of the same color,
+// including self loops
+// best is the smallest number of conflicts that was returned so far, the generator
+// lowers it to the bound of the supervisor
+// capacity is the maximum number of edges of a solution, colorings with more conflicts
+// are never returned
+// run best is the smallest number of conflicts of the current run, run colors holds a
+// coloring with run best conflicts once the run left it, until then the current coloring
+// is one, run saved tells which of both
+// rng is the random number stream of the generator
+struct LocalSearch {
+    const Graph *graph;
+    int colorCount;
+    int (*moves)(struct LocalSearch *ls, long steps);
+    int *colors;
+    int *gamma;
+    long *tabu;
+    int *conflicted;
+    int *position;
+    int conflictedCount;
+    int conflicts;
+    int best;
+    int capacity;
+    long iteration;
+    long lastImprovement;
+    int runBest;
+    int *runColors;
+    int runSaved;
+    Rng rng;
+};
+typedef struct LocalSearch LocalSearch;
+
+int localSearchInit(LocalSearch *ls, const Graph *graph, int colorCount, int capacity, uint64_t seed, uint64_t stream);
+void localSearchFree(LocalSearch *ls);
+void localSearchRestart(LocalSearch *ls);
+void localSearchRestartFrom(LocalSearch *ls, const uint8_t *colors);
+int localSearchRun(LocalSearch *ls, long steps);
+int localSearchSolution(LocalSearch *ls, Edge *solution);
+const int *localSearchRunColors(const LocalSearch *ls);
+
+#endif
@@ -0,0 +1,451 @@
+/**
+ * @file pipebench.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Benchmark of the whole pipeline. For every graph file the supervisor is started
+ * with the graph and a number of generators are started once it is ready. The output of
+ * the supervisor is timestamped while it runs, after the given time it is stopped.
+ * One CSV line per graph holds the time to the first and to the best solution, measured
+ * from the start of the generators, the best solution and the solutions per second the
+ * supervisor read. Rows are appended to the output file, so runs can be compared.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "structs.h"
+#include "instance.h"
+
+/**
+ * Pointer to name of program
+ **/
+static char *program_name;
+
+// Options of the benchmark, the same for every graph
+// engine and threads are passed to every generator, solution size to the supervisor
+struct BenchOptions {
+    int generators;
+    int threads;
+    const char *engine;
+    const char *solutionSize;
+    double duration;
+};
+typedef struct BenchOptions BenchOptions;
+
+// Result of one run, times are -1 and best is -1 if no solution was read
+struct BenchResult {
+    double first;
+    double last;
+    int best;
+    double rate;
+};
+typedef struct BenchResult BenchResult;
+
+// Growing buffer for the output of the supervisor
+struct Buffer {
+    char *content;
+    size_t length;
+    size_t capacity;
+};
+typedef struct Buffer Buffer;
+
+/**
+ * printUsageError function.
+ * @brief Usage of program is printed to stderr and program is exited with failure code
+ * @details global variables: program_name, contains the name of the program
+ **/
+static void printUsageError(void) {
+
+    fprintf(stderr, "Usage: %s [-n GENERATORS] [-t THREADS] [-e random|local|exact] [-l SOLUTIONSIZE] "
+            "[-d SECONDS] [-o FILE] GRAPHFILE...\n", program_name);
+    exit(EXIT_FAILURE);
+
+}
+
+/**
+ * returns the current time
+ * @return monotonic time in seconds
+ **/
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * appends data to a buffer
+ * @param *buffer - pointer to the buffer
+ * @param *data - the data
+ * @param length - number of bytes
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int bufferAppend(Buffer *buffer, const char *data, size_t length) {
+    if (buffer->length + length + 1 > buffer->capacity) {
+        size_t capacity = buffer->capacity == 0 ? 4096 : buffer->capacity;
+        while (buffer->length + length + 1 > capacity) {
+            capacity *= 2;
+        }
+        char *content = realloc(buffer->content, capacity);
+        if (content == NULL) {
+            return -1;
+        }
+        buffer->content = content;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->content + buffer->length, data, length);
+    buffer->length += length;
+    buffer->content[buffer->length] = '\0';
+    return 1;
+}
+
+/**
+ * starts a program
+ * @param *argv - program and arguments, NULL terminated
+ * @param out - file descriptor for stdout of the program
+ * @param err - file descriptor for stderr of the program
+ * @return process id, integer -1 if failure
+ **/
+static pid_t spawn(char *argv[], int out, int err) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        dup2(out, STDOUT_FILENO);
+        dup2(err, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    return pid;
+}
+
+/**
+ * waits until the supervisor initialized the shared memory object
+ * @param timeout - maximum time to wait in seconds
+ * @return integer 1 if the supervisor is ready, integer -1 otherwise
+ **/
+static int waitForSupervisor(double timeout) {
+    char shm_name[INSTANCE_NAME_SIZE];
+    if (instanceName(shm_name, SHM) == -1) {
+        return -1;
+    }
+
+    double end = now() + timeout;
+    while (now() < end) {
+        int shmfd = shm_open(shm_name, O_RDONLY, 0600);
+        if (shmfd != -1) {
+            struct stat shm_stat;
+            size_t size = 0;
+            if (fstat(shmfd, &shm_stat) == 0 && (size_t) shm_stat.st_size >= sizeof(ShmObj)) {
+                ShmObj *shm_obj = mmap(NULL, sizeof(ShmObj), PROT_READ, MAP_SHARED, shmfd, 0);
+                if (shm_obj != MAP_FAILED) {
+                    size = __atomic_load_n(&shm_obj->size, __ATOMIC_ACQUIRE);
+                    munmap(shm_obj, sizeof(ShmObj));
+                }
+            }
+            close(shmfd);
+            if (size != 0) {
+                return 1;
+            }
+        }
+        usleep(10000);
+    }
+    return -1;
+}
+
+/**
+ * handles the complete lines of the output of the supervisor
+ * @brief a line with a solution or the 3-colorable line updates the result,
+ * the incomplete last line stays in the buffer
+ * @param *out - the output read so far
+ * @param elapsed - time since the generators were started
+ * @param *result - the result of the run
+ **/
+static void parseLines(Buffer *out, double elapsed, BenchResult *result) {
+    char *line = out->content;
+    char *newline;
+    while ((newline = memchr(line, '\n', out->length - (line - out->content))) != NULL) {
+        *newline = '\0';
+
+        int length = -1;
+        if (strcmp(line, "The graph is 3-colorable!") == 0) {
+            length = 0;
+        } else if (sscanf(line, "Solution with %d edge", &length) != 1) {
+            length = -1;
+        }
+
+        if (length != -1 && (result->best == -1 || length < result->best)) {
+            if (result->best == -1) {
+                result->first = elapsed;
+            }
+            result->best = length;
+            result->last = elapsed;
+        }
+        line = newline + 1;
+    }
+
+    out->length -= line - out->content;
+    memmove(out->content, line, out->length);
+}
+
+/**
+ * reads the number of solutions per second from the JSON stats of the supervisor
+ * @param *err - the stderr output of the supervisor
+ * @return solutions per second, -1 if the stats are missing
+ **/
+static double parseRate(const Buffer *err) {
+    if (err->content == NULL) {
+        return -1;
+    }
+    const char *json = strstr(err->content, "{\"elapsed\":");
+    const char *read = json != NULL ? strstr(json, "\"read\":") : NULL;
+    if (read == NULL) {
+        return -1;
+    }
+    double elapsed = strtod(json + strlen("{\"elapsed\":"), NULL);
+    double solutions = strtod(read + strlen("\"read\":"), NULL);
+    return elapsed > 0 ? solutions / elapsed : -1;
+}
+
+/**
+ * benchmarks one graph
+ * @brief starts the supervisor with stats, so it prints the number of read solutions
+ * at the end, and the generators. The supervisor is stopped with SIGINT after the
+ * duration unless it found a 3-coloring before.
+ * @param *graph - path of the graph file
+ * @param *options - options of the benchmark
+ * @param *result - the result is written to it
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int runGraph(char *graph, const BenchOptions *options, BenchResult *result) {
+    result->first = -1;
+    result->last = -1;
+    result->best = -1;
+    result->rate = -1;
+
+    int out[2], err[2];
+    if (pipe(out) == -1) {
+        return -1;
+    }
+    if (pipe(err) == -1) {
+        close(out[0]);
+        close(out[1]);
+        return -1;
+    }
+    int null = open("/dev/null", O_WRONLY);
+
+    // the interval is longer than any run, the stats are only printed at the end
+    // every generator gets its own part of the graph if it has enough components
+    char parts[16];
+    snprintf(parts, sizeof(parts), "%d", options->generators < MAX_PARTS ? options->generators : MAX_PARTS);
+    char *supervisor_argv[] = { "./supervisor", "-g", graph, "-l", (char *) options->solutionSize,
+                                "-p", parts, "-i", "86400", NULL };
+    pid_t supervisor = spawn(supervisor_argv, out[1], err[1]);
+    close(out[1]);
+    close(err[1]);
+    if (supervisor == -1 || waitForSupervisor(5) == -1) {
+        fprintf(stderr, "%s: Supervisor did not start for %s.\n", program_name, graph);
+        if (supervisor != -1) {
+            kill(supervisor, SIGTERM);
+        }
+        while (wait(NULL) > 0) { }
+        close(out[0]);
+        close(err[0]);
+        close(null);
+        return -1;
+    }
+
+    char threads[16];
+    snprintf(threads, sizeof(threads), "%d", options->threads);
+    char *generator_argv[] = { "./generator", "-e", (char *) options->engine, "-t", threads, NULL };
+
+    double start = now();
+    for (int i = 0; i < options->generators; i++) {
+        spawn(generator_argv, null, null);
+    }
+    close(null);
+
+    Buffer out_buffer = { NULL, 0, 0 };
+    Buffer err_buffer = { NULL, 0, 0 };
+    struct pollfd fds[2] = { { out[0], POLLIN, 0 }, { err[0], POLLIN, 0 } };
+    int open_fds = 2;
+    int stopped = 0;
+    int exit_status = 1;
+
+    while (open_fds > 0) {
+        double remaining = start + options->duration - now();
+        if (remaining <= 0 && !stopped) {
+            kill(supervisor, SIGINT);
+            stopped = 1;
+        }
+
+        int timeout = stopped ? -1 : (int) (remaining * 1000) + 1;
+        if (poll(fds, 2, timeout) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            exit_status = -1;
+            break;
+        }
+
+        for (int i = 0; i < 2; i++) {
+            if (fds[i].fd == -1 || fds[i].revents == 0) {
+                continue;
+            }
+
+            char chunk[4096];
+            ssize_t length = read(fds[i].fd, chunk, sizeof(chunk));
+            if (length <= 0) {
+                close(fds[i].fd);
+                fds[i].fd = -1;
+                open_fds--;
+                continue;
+            }
+
+            Buffer *buffer = i == 0 ? &out_buffer : &err_buffer;
+            if (bufferAppend(buffer, chunk, length) == -1) {
+                exit_status = -1;
+            } else if (i == 0) {
+                parseLines(buffer, now() - start, result);
+            }
+        }
+    }
+
+    for (int i = 0; i < 2; i++) {
+        if (fds[i].fd != -1) {
+            close(fds[i].fd);
+        }
+    }
+    if (!stopped) {
+        kill(supervisor, SIGINT);
+    }
+    while (wait(NULL) > 0) { }
+
+    result->rate = parseRate(&err_buffer);
+    free(out_buffer.content);
+    free(err_buffer.content);
+    return exit_status;
+}
+
+/**
+ * prints a number or n/a
+ * @param *file - the file
+ * @param value - the number, negative if not available
+ **/
+static void printValue(FILE *file, double value) {
+    if (value < 0) {
+        fprintf(file, ",n/a");
+    } else {
+        fprintf(file, ",%.3f", value);
+    }
+}
+
+/**
+ * Program entry point.
+ * @brief The program starts here. -n sets the number of generator processes, default 1,
+ * -t the number of threads per generator, default 1, -e the engine of the generators,
+ * default local, with exact the run ends early once the optimum is proven. -l is passed to the supervisor, default 1024, so that also the early
+ * solutions of large graphs are read. -d sets the time per graph in seconds, default 5.
+ * -o appends the rows to a file instead of stdout, the header is written if the file is empty.
+ * The supervisor and the generator are started from the current directory.
+ * @param argc The argument counter.
+ * @param argv The argument vector.
+ * @return Returns EXIT_SUCCESS or EXIT_FAILURE
+ **/
+int main(int argc, char *argv[]) {
+    program_name = argv[0];
+
+    BenchOptions options = { 1, 1, "local", "1024", 5 };
+    const char *output = NULL;
+    char *endptr;
+    long value;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:t:e:l:d:o:")) != -1) {
+        switch (option) {
+            case 'n':
+            case 't':
+                value = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || value <= 0 || value > 1024) { printUsageError(); }
+                if (option == 'n') {
+                    options.generators = value;
+                } else {
+                    options.threads = value;
+                }
+                break;
+            case 'e':
+                if (strcmp(optarg, "random") != 0 && strcmp(optarg, "local") != 0
+                    && strcmp(optarg, "exact") != 0) { printUsageError(); }
+                options.engine = optarg;
+                break;
+            case 'l':
+                value = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || value <= 0 || value > INT_MAX) { printUsageError(); }
+                options.solutionSize = optarg;
+                break;
+            case 'd':
+                options.duration = strtod(optarg, &endptr);
+                if (*endptr != '\0' || !(options.duration > 0)) { printUsageError(); }
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            default:
+                printUsageError();
+        }
+    }
+    if (optind == argc) { printUsageError(); }
+
+    FILE *file = stdout;
+    if (output != NULL) {
+        file = fopen(output, "a");
+        if (file == NULL) {
+            fprintf(stderr, "%s: Couldn't open %s.\n", program_name, output);
+            exit(EXIT_FAILURE);
+        }
+    }
+    fseek(file, 0, SEEK_END);
+    if (file == stdout || ftell(file) <= 0) {
+        fprintf(file, "timestamp,graph,engine,generators,threads,duration,"
+                "time_to_first,time_to_best,best,solutions_per_sec\n");
+        fflush(file);
+    }
+
+    int exit_code = EXIT_SUCCESS;
+    for (int i = optind; i < argc; i++) {
+        BenchResult result;
+        if (runGraph(argv[i], &options, &result) == -1) {
+            exit_code = EXIT_FAILURE;
+            continue;
+        }
+
+        fprintf(file, "%ld,%s,%s,%d,%d,%.1f", (long) time(NULL), argv[i], options.engine,
+                options.generators, options.threads, options.duration);
+        printValue(file, result.first);
+        printValue(file, result.last);
+        if (result.best < 0) {
+            fprintf(file, ",n/a");
+        } else {
+            fprintf(file, ",%d", result.best);
+        }
+        printValue(file, result.rate);
+        fprintf(file, "\n");
+        fflush(file);
+    }
+
+    if (file != stdout) {
+        fclose(file);
+    }
+    exit(exit_code);
+}
@@ -0,0 +1,490 @@
+/**
+ * @file preprocess.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Preprocessing module. A vertex with less neighbours than colors always gets a
+ * color none of its neighbours has, so it is removed and colored last. Removing it can
+ * lower the degree of its neighbours, the vertices are peeled until every remaining
+ * vertex has at least as many neighbours as colors. The rest splits into connected components, they
+ * are colored independently and the solution of the graph is the union of the best
+ * solution of every component. The components are spread over the parts, which the
+ * generators search, and the best solution of every component starts from a greedy coloring.
+ *
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "preprocess.h"
+#include "graph.h"
+
+// Sort key of a vertex or a component, larger keys come first
+struct SortKey {
+    int key;
+    int index;
+};
+typedef struct SortKey SortKey;
+
+/**
+ * compares two sort keys
+ * @param *a - first key
+ * @param *b - second key
+ * @return negative if a comes first, positive if b comes first
+ **/
+static int compareKeys(const void *a, const void *b) {
+    const SortKey *x = a;
+    const SortKey *y = b;
+    if (x->key != y->key) {
+        return x->key > y->key ? -1 : 1;
+    }
+    return x->index < y->index ? -1 : x->index > y->index;
+}
+
+/**
+ * removes the vertices with less neighbours than colors
+ * @brief the degree of the remaining vertices is lowered by their peeled neighbours,
+ * peeled vertices get the component -1, all other vertices -2
+ * @param *pre - the preprocessing result, component and peeled are written
+ * @param *graph - the graph
+ * @param *degree - number of remaining neighbours of every vertex, counted with multiple edges
+ * @param *queue - space for one entry per vertex
+ **/
+static void peelVertices(Preprocess *pre, const Graph *graph, int *degree, int *queue) {
+    int tail = 0;
+    for (int v = 0; v < graph->vertices; v++) {
+        degree[v] = graph->offsets[v + 1] - graph->offsets[v];
+        pre->component[v] = -2;
+        if (degree[v] < pre->colorCount) {
+            pre->component[v] = -1;
+            queue[tail++] = v;
+        }
+    }
+
+    for (int head = 0; head < tail; head++) {
+        int v = queue[head];
+        for (int i = graph->offsets[v]; i < graph->offsets[v + 1]; i++) {
+            int u = graph->adjacent[i];
+            if (pre->component[u] != -1 && --degree[u] < pre->colorCount) {
+                pre->component[u] = -1;
+                queue[tail++] = u;
+            }
+        }
+    }
+    pre->peeled = tail;
+}
+
+/**
+ * labels the connected components of the remaining vertices
+ * @brief breadth first search from every unlabeled vertex
+ * @param *pre - the preprocessing result, component and components are written
+ * @param *graph - the graph
+ * @param *queue - space for one entry per vertex
+ **/
+static void labelComponents(Preprocess *pre, const Graph *graph, int *queue) {
+    pre->components = 0;
+    for (int s = 0; s < graph->vertices; s++) {
+        if (pre->component[s] != -2) {
+            continue;
+        }
+
+        int head = 0;
+        int tail = 0;
+        pre->component[s] = pre->components;
+        queue[tail++] = s;
+        while (head < tail) {
+            int v = queue[head++];
+            for (int i = graph->offsets[v]; i < graph->offsets[v + 1]; i++) {
+                int u = graph->adjacent[i];
+                if (pre->component[u] == -2) {
+                    pre->component[u] = pre->components;
+                    queue[tail++] = u;
+                }
+            }
+        }
+        pre->components++;
+    }
+}
+
+/**
+ * checks if an edge belongs to a component
+ * @param *pre - the preprocessing result
+ * @param *edge - the edge in the original numbering
+ * @return the component of the edge, -1 for self loops and edges of peeled vertices
+ **/
+static int edgeComponent(const Preprocess *pre, const Edge *edge) {
+    if (edge->from == edge->to || pre->component[edge->from] < 0 || pre->component[edge->to] < 0) {
+        return -1;
+    }
+    return pre->component[edge->from];
+}
+
+/**
+ * sorts the components by their number of edges and spreads them over the parts
+ * @brief every component goes to the part with the fewest edges so far, largest first
+ * @param *pre - the preprocessing result, the components are renumbered
+ * @param *edges - the edges of the graph
+ * @param length - number of edges
+ * @param parts - maximum number of parts
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int assignParts(Preprocess *pre, const Edge *edges, int length, int parts) {
+    int components = pre->components;
+    SortKey *keys = calloc(components + 1, sizeof(SortKey));
+    int *rank = malloc((components + 1) * sizeof(int));
+    if (keys == NULL || rank == NULL) {
+        free(keys);
+        free(rank);
+        return -1;
+    }
+
+    for (int c = 0; c < components; c++) {
+        keys[c].index = c;
+    }
+    for (int i = 0; i < length; i++) {
+        int c = edgeComponent(pre, &edges[i]);
+        if (c >= 0) {
+            keys[c].key++;
+        }
+    }
+    qsort(keys, components, sizeof(SortKey), compareKeys);
+
+    pre->parts = parts < components ? parts : components;
+    int load[MAX_PARTS] = { 0 };
+    for (int c = 0; c < components; c++) {
+        rank[keys[c].index] = c;
+        pre->capacity[c] = keys[c].key;
+
+        int lightest = 0;
+        for (int p = 1; p < pre->parts; p++) {
+            if (load[p] < load[lightest]) {
+                lightest = p;
+            }
+        }
+        pre->part[c] = lightest;
+        load[lightest] += keys[c].key;
+    }
+
+    for (int v = 0; v < pre->vertices; v++) {
+        if (pre->component[v] >= 0) {
+            pre->component[v] = rank[pre->component[v]];
+        }
+    }
+
+    free(keys);
+    free(rank);
+    return 1;
+}
+
+/**
+ * builds the edges of every part in its own numbering
+ * @param *pre - the preprocessing result, members, edges and original are written
+ * @param *edges - the edges of the graph
+ * @param length - number of edges
+ * @param *local - space for one entry per vertex
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int buildParts(Preprocess *pre, const Edge *edges, int length, int *local) {
+    for (int c = 0; c < pre->components; c++) {
+        pre->memberStart[pre->part[c] + 1]++;
+    }
+    for (int p = 0; p < pre->parts; p++) {
+        pre->memberStart[p + 1] += pre->memberStart[p];
+    }
+    int fill[MAX_PARTS];
+    memcpy(fill, pre->memberStart, pre->parts * sizeof(int));
+    for (int c = 0; c < pre->components; c++) {
+        pre->members[fill[pre->part[c]]++] = c;
+    }
+
+    for (int v = 0; v < pre->vertices; v++) {
+        if (pre->component[v] >= 0) {
+            int p = pre->part[pre->component[v]];
+            local[v] = pre->originalStart[p + 1]++;
+        }
+    }
+    for (int p = 0; p < pre->parts; p++) {
+        pre->originalStart[p + 1] += pre->originalStart[p];
+    }
+    for (int v = 0; v < pre->vertices; v++) {
+        if (pre->component[v] >= 0) {
+            int p = pre->part[pre->component[v]];
+            pre->original[pre->originalStart[p] + local[v]] = v;
+        }
+    }
+
+    for (int c = 0; c < pre->components; c++) {
+        pre->edges[pre->part[c]].length += pre->capacity[c];
+    }
+    for (int p = 0; p < pre->parts; p++) {
+        pre->edges[p].content = malloc((pre->edges[p].length + 1) * sizeof(Edge));
+        if (pre->edges[p].content == NULL) {
+            return -1;
+        }
+        pre->edges[p].length = 0;
+    }
+    for (int i = 0; i < length; i++) {
+        int c = edgeComponent(pre, &edges[i]);
+        if (c >= 0) {
+            EdgeArray *part = &pre->edges[pre->part[c]];
+            part->content[part->length].from = local[edges[i].from];
+            part->content[part->length].to = local[edges[i].to];
+            part->length++;
+        }
+    }
+    return 1;
+}
+
+/**
+ * colors the remaining vertices greedily
+ * @brief the vertices are colored by falling degree with the color the fewest colored
+ * neighbours have, the conflicts are the first best solution of every component
+ * @param *pre - the preprocessing result, best, forced and the lengths are written
+ * @param *graph - the graph
+ * @param *edges - the edges of the graph
+ * @param length - number of edges
+ * @param *degree - number of remaining neighbours of every vertex
+ * @param *colors - space for one entry per vertex
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int colorGreedy(Preprocess *pre, const Graph *graph, const Edge *edges, int length,
+                       const int *degree, int *colors) {
+    int remaining = pre->vertices - pre->peeled;
+    SortKey *keys = malloc((remaining + 1) * sizeof(SortKey));
+    if (keys == NULL) {
+        return -1;
+    }
+
+    int count = 0;
+    for (int v = 0; v < pre->vertices; v++) {
+        colors[v] = -1;
+        if (pre->component[v] >= 0) {
+            keys[count].key = degree[v];
+            keys[count].index = v;
+            count++;
+        }
+    }
+    qsort(keys, count, sizeof(SortKey), compareKeys);
+
+    for (int i = 0; i < count; i++) {
+        int v = keys[i].index;
+        int cost[MAX_COLORS] = { 0 };
+        for (int j = graph->offsets[v]; j < graph->offsets[v + 1]; j++) {
+            int u = graph->adjacent[j];
+            if (colors[u] >= 0) {
+                cost[colors[u]]++;
+            }
+        }
+        colors[v] = 0;
+        for (int c = 1; c < pre->colorCount; c++) {
+            if (cost[c] < cost[colors[v]]) {
+                colors[v] = c;
+            }
+        }
+    }
+    free(keys);
+
+    for (int c = 0; c < pre->components; c++) {
+        pre->best[c].content = malloc((pre->capacity[c] + 1) * sizeof(Edge));
+        if (pre->best[c].content == NULL) {
+            return -1;
+        }
+    }
+    for (int i = 0; i < length; i++) {
+        int c = edgeComponent(pre, &edges[i]);
+        if (edges[i].from == edges[i].to) {
+            pre->forced.content[pre->forced.length++] = edges[i];
+        } else if (c >= 0 && colors[edges[i].from] == colors[edges[i].to]) {
+            pre->best[c].content[pre->best[c].length++] = edges[i];
+        }
+    }
+
+    pre->length = pre->forced.length;
+    for (int c = 0; c < pre->components; c++) {
+        pre->partLength[pre->part[c]] += pre->best[c].length;
+        pre->length += pre->best[c].length;
+    }
+    return 1;
+}
+
+/**
+ * preprocesses a graph
+ * @brief peels the vertices with less neighbours than colors, splits the rest into
+ * connected components, spreads them over at most parts parts and colors them greedily
+ * @param *pre - the preprocessing result
+ * @param *edges - the edges of the graph
+ * @param length - number of edges
+ * @param parts - maximum number of parts, at least 1 and at most MAX_PARTS
+ * @param colorCount - number of colors, between 2 and MAX_COLORS
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int preprocessGraph(Preprocess *pre, const Edge *edges, int length, int parts, int colorCount) {
+    memset(pre, 0, sizeof(*pre));
+    pre->colorCount = colorCount;
+
+    Graph graph;
+    if (graphCreateLocal(&graph, edges, length) == -1) {
+        return -1;
+    }
+
+    int vertices = graph.vertices;
+    pre->vertices = vertices;
+    pre->component = malloc((vertices + 1) * sizeof(int));
+    pre->forced.content = malloc((graph.selfLoops + 1) * sizeof(Edge));
+    int *degree = malloc((vertices + 1) * sizeof(int));
+    int *scratch = malloc((vertices + 1) * sizeof(int));
+    if (pre->component == NULL || pre->forced.content == NULL || degree == NULL || scratch == NULL) {
+        free(degree);
+        free(scratch);
+        graphClose(&graph);
+        preprocessFree(pre);
+        return -1;
+    }
+
+    peelVertices(pre, &graph, degree, scratch);
+    labelComponents(pre, &graph, scratch);
+
+    int components = pre->components;
+    pre->capacity = calloc(components + 1, sizeof(int));
+    pre->best = calloc(components + 1, sizeof(EdgeArray));
+    pre->part = calloc(components + 1, sizeof(int));
+    pre->members = calloc(components + 1, sizeof(int));
+    pre->count = calloc(components + 1, sizeof(int));
+    pre->memberStart = calloc(MAX_PARTS + 1, sizeof(int));
+    pre->originalStart = calloc(MAX_PARTS + 1, sizeof(int));
+    pre->edges = calloc(MAX_PARTS, sizeof(EdgeArray));
+    pre->partLength = calloc(MAX_PARTS, sizeof(int));
+    pre->original = malloc((vertices - pre->peeled + 1) * sizeof(int));
+
+    int status = -1;
+    if (pre->capacity != NULL && pre->best != NULL && pre->part != NULL && pre->members != NULL
+        && pre->count != NULL && pre->memberStart != NULL && pre->originalStart != NULL
+        && pre->edges != NULL && pre->partLength != NULL && pre->original != NULL
+        && assignParts(pre, edges, length, parts) == 1
+        && buildParts(pre, edges, length, scratch) == 1
+        && colorGreedy(pre, &graph, edges, length, degree, scratch) == 1) {
+        status = 1;
+    }
+
+    free(degree);
+    free(scratch);
+    graphClose(&graph);
+    if (status == -1) {
+        preprocessFree(pre);
+    }
+    return status;
+}
+
+/**
+ * releases the memory of a preprocessing result
+ * @param *pre - the preprocessing result
+ **/
+void preprocessFree(Preprocess *pre) {
+    if (pre->best != NULL) {
+        for (int c = 0; c < pre->components; c++) {
+            free(pre->best[c].content);
+        }
+    }
+    if (pre->edges != NULL) {
+        for (int p = 0; p < MAX_PARTS; p++) {
+            free(pre->edges[p].content);
+        }
+    }
+    free(pre->component);
+    free(pre->forced.content);
+    free(pre->capacity);
+    free(pre->best);
+    free(pre->part);
+    free(pre->members);
+    free(pre->memberStart);
+    free(pre->edges);
+    free(pre->original);
+    free(pre->originalStart);
+    free(pre->partLength);
+    free(pre->count);
+    memset(pre, 0, sizeof(*pre));
+}
+
+/**
+ * translates an edge of a solution to the original numbering
+ * @param *pre - the preprocessing result
+ * @param part - part of the solution, -1 for the original numbering
+ * @param *edge - the edge of the solution
+ * @param *original - the translated edge is written to it
+ * @return the component of the edge, -1 for edges that are not needed or invalid
+ **/
+static int translateEdge(const Preprocess *pre, int part, const Edge *edge, Edge *original) {
+    int base = 0;
+    int vertices = pre->vertices;
+    if (part >= 0) {
+        base = pre->originalStart[part];
+        vertices = pre->originalStart[part + 1] - base;
+    }
+    if (edge->from < 0 || edge->from >= vertices || edge->to < 0 || edge->to >= vertices) {
+        return -1;
+    }
+
+    *original = *edge;
+    if (part >= 0) {
+        original->from = pre->original[base + edge->from];
+        original->to = pre->original[base + edge->to];
+    }
+    return edgeComponent(pre, original);
+}
+
+/**
+ * merges a solution into the best solutions of the components
+ * @brief a solution of a part colors all components of the part, a solution of the
+ * whole graph all components. A component gets the edges of the solution that belong
+ * to it, if they are less than its best solution. Edges of peeled vertices are dropped,
+ * recoloring the peeled vertices removes them.
+ * @param *pre - the preprocessing result
+ * @param part - part of the solution, -1 for a solution in the original numbering
+ * @param *edges - the edges of the solution
+ * @param length - number of edges
+ * @return integer 1 if a component got a better solution, integer 0 otherwise
+ **/
+int preprocessMerge(Preprocess *pre, int part, const Edge *edges, int length) {
+    if (part >= pre->parts) {
+        return 0;
+    }
+
+    Edge edge;
+    for (int i = 0; i < length; i++) {
+        int c = translateEdge(pre, part, &edges[i], &edge);
+        if (c >= 0) {
+            pre->count[c]++;
+        }
+    }
+
+    int first = part >= 0 ? pre->memberStart[part] : 0;
+    int last = part >= 0 ? pre->memberStart[part + 1] : pre->components;
+    int improved = 0;
+    for (int i = first; i < last; i++) {
+        int c = part >= 0 ? pre->members[i] : i;
+        if (pre->count[c] < pre->best[c].length) {
+            pre->partLength[pre->part[c]] -= pre->best[c].length;
+            pre->length -= pre->best[c].length;
+            pre->best[c].length = 0;
+            pre->count[c] = -1;
+            improved = 1;
+        } else {
+            pre->count[c] = 0;
+        }
+    }
+
+    if (improved) {
+        for (int i = 0; i < length; i++) {
+            int c = translateEdge(pre, part, &edges[i], &edge);
+            if (c >= 0 && pre->count[c] == -1) {
+                pre->best[c].content[pre->best[c].length++] = edge;
+                pre->partLength[pre->part[c]]++;
+                pre->length++;
+            }
+        }
+        for (int i = first; i < last; i++) {
+            pre->count[part >= 0 ? pre->members[i] : i] = 0;
+        }
+    }
+    return improved;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file preprocess.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Preprocessing of the graph of the supervisor and merging of the solutions
+ * of its components.
+ *
+ **/
+
+#ifndef PREPROCESS_H
+#define PREPROCESS_H
+
+#include "structs.h"
+
+// Graph of the supervisor after preprocessing and the best solution of every component
+// color count is the number of colors k
+// vertices is the number of vertices, peeled the number of vertices with less than k
+// neighbours that were removed one after another, they are colored last without conflicts
+// component[v] is the component of the remaining vertex v, -1 if v was peeled
+// forced holds the self loops, they are part of every solution
+// the components are sorted by their number of edges, capacity[c] is the number of
+// edges of component c, best[c] its best solution in the original numbering
+// part[c] is the part of component c, the components of part p are
+// members[memberStart[p]] ... members[memberStart[p + 1] - 1]
+// edges[p] holds the edges of part p numbered from 0 in every part, vertex i of part p
+// is original[originalStart[p] + i]
+// partLength[p] is the number of edges of the best solutions of the components of part p,
+// length the number of edges of the whole solution including forced
+// count is scratch space with one entry per component used while merging
+struct Preprocess {
+    int colorCount;
+    int vertices;
+    int peeled;
+    int *component;
+    EdgeArray forced;
+    int components;
+    int *capacity;
+    EdgeArray *best;
+    int *part;
+    int parts;
+    int *members;
+    int *memberStart;
+    EdgeArray *edges;
+    int *original;
+    int *originalStart;
+    int *partLength;
+    int length;
+    int *count;
+};
+typedef struct Preprocess Preprocess;
+
+int preprocessGraph(Preprocess *pre, const Edge *edges, int length, int parts, int colorCount);
+void preprocessFree(Preprocess *pre);
+int preprocessMerge(Preprocess *pre, int part, const Edge *edges, int length);
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file randomsearch.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Random engine. Colors every vertex randomly and collects the edges between
+ * vertices of the same color. The edges are counted in blocks by the conflict kernel,
+ * only blocks with conflicts are looked at edge by edge. All memory is allocated once
+ * in the workspace, an attempt does not allocate anything.
+ *
+ **/
+
+#include <stdlib.h>
+
+#include "randomsearch.h"
+
+/**
+ * initializes the workspace
+ * @param *rs - pointer to the workspace
+ * @param *graph - the graph, it has to stay valid until the workspace is freed
+ * @param colorCount - number of colors, between 2 and MAX_COLORS
+ * @param kernel - the conflict kernel, usually returned by kernelSelect
+ * @param seed - seed of the run
+ * @param stream - random number stream of this generator
+ * @return integer 1 if success, integer -1 if failure
+ **/
+int randomSearchInit(RandomSearch *rs, const Graph *graph, int colorCount, ConflictKernel kernel, uint64_t seed, uint64_t stream) {
+    rs->graph = graph;
+    rs->colorCount = colorCount;
+    rs->kernel = kernel;
+    rngSeed(&rs->rng, seed, stream);
+    rs->colors = calloc(graph->vertices + KERNEL_PADDING, sizeof(uint8_t));
+    if (rs->colors == NULL) {
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * frees the workspace
+ * @param *rs - pointer to the workspace
+ **/
+void randomSearchFree(RandomSearch *rs) {
+    free(rs->colors);
+}
+
+/**
+ * generates a new solution
+ * @brief adds a random coloring to the vertexes and writes the edges between vertexes with
+ * the same color directly to the solution. The scan is aborted as soon as the number of
+ * these edges reaches the bound, such a coloring is not better than the best solution of
+ * the supervisor and is not published.
+ * @param *rs - pointer to the workspace
+ * @param bound - number of edges at which the attempt is aborted
+ * @param capacity - maximum number of edges of a solution
+ * @param *solution - array of capacity edges the solution is written to
+ * @return number of edges of the solution, integer -1 if the attempt was aborted or
+ * the solution has more than capacity edges
+ **/
+int randomSearchGenerate(RandomSearch *rs, int bound, int capacity, Edge *solution) {
+    const Graph *graph = rs->graph;
+    uint8_t *colors = rs->colors;
+
+    rngColors(&rs->rng, colors, graph->vertices, rs->colorCount);
+
+    int conflicts = 0;
+    for (int begin = 0; begin < graph->length; begin += KERNEL_BLOCK) {
+        int end = begin + KERNEL_BLOCK < graph->length ? begin + KERNEL_BLOCK : graph->length;
+
+        int count = rs->kernel(graph->from, graph->to, colors, begin, end);
+        if (count == 0) {
+            continue;
+        }
+        if (conflicts + count >= bound || conflicts + count > capacity) {
+            return -1;
+        }
+
+        for (int i = begin; i < end; i++) {
+            if (colors[graph->from[i]] == colors[graph->to[i]]) {
+                solution[conflicts].from = graph->from[i];
+                solution[conflicts].to = graph->to[i];
+                conflicts++;
+            }
+        }
+    }
+
+    return conflicts;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file randomsearch.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Contains structs for randomsearch.c
+ *
+ **/
+
+#ifndef RANDOMSEARCH_H
+#define RANDOMSEARCH_H
+
+#include <stdint.h>
+
+#include "structs.h"
+#include "graph.h"
+#include "kernel.h"
+#include "rng.h"
+
+// Workspace of the random engine, allocated once per generator
+// graph is the searched graph
+// colors holds one byte per vertex and is overwritten by every attempt, color count is
+// the number of colors
+// kernel counts the conflicts of a block of edges
+// rng is the random number stream of the generator
+struct RandomSearch {
+    const Graph *graph;
+    uint8_t *colors;
+    int colorCount;
+    ConflictKernel kernel;
+    Rng rng;
+};
+typedef struct RandomSearch RandomSearch;
+
+int randomSearchInit(RandomSearch *rs, const Graph *graph, int colorCount, ConflictKernel kernel, uint64_t seed, uint64_t stream);
+void randomSearchFree(RandomSearch *rs);
+int randomSearchGenerate(RandomSearch *rs, int bound, int capacity, Edge *solution);
+
+#endif
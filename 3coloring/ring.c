@@ -0,0 +1,428 @@
+/**
+ * @file ring.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Ring module. Generators claim slots of the circular buffer by atomically
+ * incrementing the write position and publish them through the slot sequence number,
+ * so no generator has to wait for another one. Waiting for a free slot or for a published
+ * solution first polls the shared memory object for spin rounds and only then sleeps on a
+ * futex in it. The side that makes progress only enters the kernel if somebody sleeps, so
+ * as long as the buffer is neither full nor empty for long nobody makes a system call.
+ *
+ **/
+
+#include <stddef.h>
+#include <limits.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "ring.h"
+
+/**
+ * tells the processor that the thread is polling
+ **/
+static void ringPause(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+/**
+ * sleeps while a futex word has a value
+ * @param *word - futex word in the shared memory object
+ * @param value - expected value, the call returns at once if the word differs
+ * @param *deadline - time on the monotonic clock at which the sleep ends, NULL for none
+ * @return integer 1 if woken or the word differed, integer -1 if failure (errno is set,
+ * EINTR if a signal arrived, ETIMEDOUT if the deadline passed)
+ **/
+static int futexWait(uint32_t *word, uint32_t value, const struct timespec *deadline) {
+    long result;
+    if (deadline == NULL) {
+        result = syscall(SYS_futex, word, FUTEX_WAIT, value, NULL, NULL, 0);
+    } else {
+        result = syscall(SYS_futex, word, FUTEX_WAIT_BITSET, value, deadline, NULL, FUTEX_BITSET_MATCH_ANY);
+    }
+    if (result == -1 && errno != EAGAIN) {
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * wakes threads sleeping on a futex word
+ * @param *word - futex word in the shared memory object
+ * @param count - maximum number of woken threads
+ **/
+static void futexWake(uint32_t *word, int count) {
+    syscall(SYS_futex, word, FUTEX_WAKE, count, NULL, NULL, 0);
+}
+
+/**
+ * takes free slots without waiting
+ * @param *shm - pointer to the shared memory object
+ * @param max - maximum number of slots
+ * @return number of taken slots, 0 if no slot is free
+ **/
+static int takeFree(ShmObj *shm, int max) {
+    uint32_t free = __atomic_load_n(&shm->freeSlots, __ATOMIC_SEQ_CST);
+    while (free > 0) {
+        uint32_t taken = free < (uint32_t) max ? free : (uint32_t) max;
+        if (__atomic_compare_exchange_n(&shm->freeSlots, &free, free - taken, 0,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            return taken;
+        }
+    }
+    return 0;
+}
+
+/**
+ * returns slots to the free slots and wakes sleeping generators
+ * @param *shm - pointer to the shared memory object
+ * @param count - number of slots
+ **/
+static void giveFree(ShmObj *shm, int count) {
+    __atomic_fetch_add(&shm->freeSlots, count, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&shm->freeWaiters, __ATOMIC_SEQ_CST) > 0) {
+        futexWake(&shm->freeSlots, count);
+    }
+}
+
+/**
+ * returns the distance between two slots
+ * @brief a slot holds its header and solutionSize edges, rounded up to whole cache lines
+ * unless the ring is built with RING_PACKED
+ * @param solutionSize - maximum number of edges of a solution
+ * @return size of a slot in bytes
+ **/
+static size_t slotSize(int solutionSize) {
+    size_t size = sizeof(Slot) + (size_t) solutionSize * sizeof(Edge);
+    return (size + RING_ALIGN - 1) / RING_ALIGN * RING_ALIGN;
+}
+
+/**
+ * returns the size of a shared memory object
+ * @param ringSize - number of slots
+ * @param solutionSize - maximum number of edges of a solution
+ * @return size of the shared memory object in bytes
+ **/
+size_t ringObjectSize(int ringSize, int solutionSize) {
+    return sizeof(ShmObj) + (size_t) ringSize * slotSize(solutionSize);
+}
+
+/**
+ * initializes the circular buffer
+ * @brief writes the sizes into the header, resets read and write position and sets the
+ * sequence number of every slot to its index, which marks the slot as free for the first
+ * round. All slots are free. The object has to be ringObjectSize(ringSize, solutionSize)
+ * bytes large. The size is written last, a generator that sees it sees the whole header.
+ * @param *shm - pointer to the mapped shared memory object
+ * @param ringSize - number of slots
+ * @param solutionSize - maximum number of edges of a solution
+ * @param spin - number of polls before a wait sleeps
+ **/
+void ringInit(ShmObj *shm, int ringSize, int solutionSize, int spin) {
+    shm->ringSize = ringSize;
+    shm->solutionSize = solutionSize;
+    shm->spin = spin;
+    shm->slotSize = slotSize(solutionSize);
+    shm->writePos = 0;
+    shm->freeSlots = ringSize;
+    shm->freeWaiters = 0;
+    shm->readPos = 0;
+    shm->usedSeq = 0;
+    shm->consumerWaiting = 0;
+
+    Ring ring = { shm, spin };
+    for (uint64_t i = 0; i < (uint64_t) ringSize; i++) {
+        ringSlot(&ring, i)->length = 0;
+        ringSlot(&ring, i)->flags = 0;
+        __atomic_store_n(&ringSlot(&ring, i)->seq, i, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&shm->size, ringObjectSize(ringSize, solutionSize), __ATOMIC_RELEASE);
+}
+
+/**
+ * returns the default number of polls before sleeping
+ * @brief polling only helps if the other side runs at the same time on another processor
+ * @return RING_DEFAULT_SPIN on machines with more than one processor, 0 otherwise
+ **/
+int ringDefaultSpin(void) {
+    return sysconf(_SC_NPROCESSORS_ONLN) > 1 ? RING_DEFAULT_SPIN : 0;
+}
+
+/**
+ * advises the kernel about the mapped shared memory object
+ * @brief large objects are backed by transparent huge pages if the kernel supports it
+ * for shared memory, then the whole buffer needs only a few TLB entries. Smaller objects
+ * and kernels without support keep normal pages, the advice is only a hint.
+ * @param *memory - start of the mapping
+ * @param size - size of the mapping
+ **/
+void ringAdvise(void *memory, size_t size) {
+#ifdef MADV_HUGEPAGE
+    if (size >= RING_HUGEPAGE_SIZE) {
+        madvise(memory, size, MADV_HUGEPAGE);
+    }
+#endif
+    (void) memory;
+    (void) size;
+}
+
+/**
+ * takes free slots and claims their positions without waiting
+ * @brief the sequence number of the claim is odd from before the slots are taken until
+ * their positions are recorded, a worker that dies in between leaves it odd
+ * @param *shm - pointer to the shared memory object
+ * @param max - maximum number of slots
+ * @param *pos - the first claimed position is written to it
+ * @param *claim - the claimed slots are recorded in it, NULL to claim without a record
+ * @return number of claimed slots, 0 if no slot is free
+ **/
+static int takeClaim(ShmObj *shm, int max, uint64_t *pos, Claim *claim) {
+    uint32_t seq = 0;
+    if (claim != NULL) {
+        seq = claim->seq;
+        __atomic_store_n(&claim->seq, seq + 1, __ATOMIC_SEQ_CST);
+    }
+
+    int claimed = takeFree(shm, max);
+    if (claimed > 0) {
+        *pos = __atomic_fetch_add(&shm->writePos, claimed, __ATOMIC_SEQ_CST);
+        if (claim != NULL) {
+            __atomic_store_n(&claim->pos, *pos, __ATOMIC_RELAXED);
+            __atomic_store_n(&claim->count, claimed, __ATOMIC_RELAXED);
+        }
+    }
+
+    if (claim != NULL) {
+        __atomic_store_n(&claim->seq, seq + 2, __ATOMIC_SEQ_CST);
+    }
+    return claimed;
+}
+
+/**
+ * claims consecutive slots for a generator
+ * @brief takes as many free slots as available, at least one and up to max, and claims
+ * them with one increment of the write position. Free slots are taken in one step, so
+ * two generators never block each other while both hold a part of a batch. If no slot
+ * is free the generator polls spin times and then sleeps until the supervisor releases
+ * a slot or terminates. The free slots never let more than ringSize positions ahead of
+ * the supervisor, so the claimed slots have always been released by the supervisor already.
+ * The claimed slots are recorded in claim before the sequence number of the claim is even
+ * again, the worker clears the count after publishing them.
+ * @param *ring - pointer to the circular buffer
+ * @param max - maximum number of slots to claim
+ * @param *pos - the first claimed position is written to it
+ * @param *claim - the claimed slots are recorded in it, NULL to claim without a record
+ * @return number of claimed slots, integer 0 if the supervisor terminates while the
+ * generator waits, integer -1 if failure (errno is set, EINTR if a signal arrived)
+ **/
+int ringClaim(Ring *ring, int max, uint64_t *pos, Claim *claim) {
+    ShmObj *shm = ring->shm;
+
+    int claimed = takeClaim(shm, max, pos, claim);
+    for (int i = 0; claimed == 0 && i < ring->spin; i++) {
+        ringPause();
+        claimed = takeClaim(shm, max, pos, claim);
+    }
+
+    if (claimed == 0) {
+        __atomic_fetch_add(&shm->freeWaiters, 1, __ATOMIC_SEQ_CST);
+        while ((claimed = takeClaim(shm, max, pos, claim)) == 0) {
+            if (__atomic_load_n(&shm->terminate, __ATOMIC_ACQUIRE) == 1
+                || futexWait(&shm->freeSlots, 0, NULL) == -1) {
+                break;
+            }
+        }
+        int error = errno;
+        __atomic_fetch_sub(&shm->freeWaiters, 1, __ATOMIC_SEQ_CST);
+        errno = error;
+
+        if (claimed == 0) {
+            return __atomic_load_n(&shm->terminate, __ATOMIC_ACQUIRE) == 1 ? 0 : -1;
+        }
+    }
+    return claimed;
+}
+
+/**
+ * gives claimed slots back without publishing them
+ * @brief used by generators that see the terminate flag after claiming, so that other
+ * generators waiting for a free slot wake up and see the flag, too
+ * @param *ring - pointer to the circular buffer
+ * @param count - number of slots returned by ringClaim
+ **/
+void ringUnclaim(Ring *ring, int count) {
+    giveFree(ring->shm, count);
+}
+
+/**
+ * returns the slot of a position
+ * @param *ring - pointer to the circular buffer
+ * @param pos - claimed or acquired position
+ * @return pointer to the slot
+ **/
+Slot *ringSlot(Ring *ring, uint64_t pos) {
+    ShmObj *shm = ring->shm;
+    return (Slot *) (shm->data + (pos % (uint64_t) shm->ringSize) * shm->slotSize);
+}
+
+/**
+ * publishes claimed slots
+ * @brief sets the sequence numbers so the supervisor sees the written lengths and edges
+ * and rings the doorbell once for the whole batch, but only if the supervisor sleeps
+ * @param *ring - pointer to the circular buffer
+ * @param pos - position returned by ringClaim
+ * @param count - number of slots returned by ringClaim
+ * @return integer 1 if success
+ **/
+int ringPublish(Ring *ring, uint64_t pos, int count) {
+    ShmObj *shm = ring->shm;
+    for (int i = 0; i < count; i++) {
+        __atomic_store_n(&ringSlot(ring, pos + i)->seq, pos + i + 1, __ATOMIC_RELEASE);
+    }
+
+    // pairs with the fence in ringAcquire, either the supervisor sees the sequence
+    // numbers or the generator sees that it sleeps
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&shm->consumerWaiting, __ATOMIC_RELAXED)) {
+        __atomic_fetch_add(&shm->usedSeq, 1, __ATOMIC_SEQ_CST);
+        futexWake(&shm->usedSeq, 1);
+    }
+    return 1;
+}
+
+/**
+ * acquires the next slot for the supervisor
+ * @brief returns immediately while published slots are ready, so the supervisor drains
+ * all slots of a batch per wakeup. If the slot at the read position is not published yet
+ * the supervisor polls spin times, then it announces that it sleeps and sleeps on the
+ * doorbell until a generator rings it or the deadline passes. The deadline is checked by
+ * the kernel, so unlike a signal it can not arrive just before the supervisor sleeps.
+ * @param *ring - pointer to the circular buffer
+ * @param *pos - the read position is written to it
+ * @param *deadline - time on the monotonic clock at which the wait ends, NULL for none
+ * @return integer 1 if success, integer -1 if failure (errno is set, EINTR if a signal
+ * arrived, ETIMEDOUT if the deadline passed)
+ **/
+int ringAcquire(Ring *ring, uint64_t *pos, const struct timespec *deadline) {
+    ShmObj *shm = ring->shm;
+    *pos = shm->readPos;
+    Slot *slot = ringSlot(ring, *pos);
+
+    for (int i = 0; i < ring->spin; i++) {
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) == *pos + 1) {
+            return 1;
+        }
+        ringPause();
+    }
+
+    while (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != *pos + 1) {
+        uint32_t doorbell = __atomic_load_n(&shm->usedSeq, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&shm->consumerWaiting, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        int status = 1;
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != *pos + 1) {
+            status = futexWait(&shm->usedSeq, doorbell, deadline);
+        }
+        __atomic_store_n(&shm->consumerWaiting, 0, __ATOMIC_RELAXED);
+        if (status == -1) {
+            return -1;
+        }
+    }
+    return 1;
+}
+
+/**
+ * releases a slot that was read by the supervisor
+ * @brief marks the slot as free for the next round, advances the read position and
+ * wakes a generator if one sleeps
+ * @param *ring - pointer to the circular buffer
+ * @param pos - position returned by ringAcquire
+ * @return integer 1 if success
+ **/
+int ringRelease(Ring *ring, uint64_t pos) {
+    __atomic_store_n(&ringSlot(ring, pos)->seq, pos + ring->shm->ringSize, __ATOMIC_RELEASE);
+    ring->shm->readPos = pos + 1;
+    giveFree(ring->shm, 1);
+    return 1;
+}
+
+/**
+ * recovers the free slots and positions of workers that died while claiming
+ * @brief only possible while no worker claims, every sequence number is even before and
+ * after the counters are read. Then the free slots, the slots between the read and the
+ * write position and the slots that dead workers took add up to ringSize, the missing
+ * ones are given back. A position between the read and the write position that is neither
+ * published nor recorded in a claim was claimed by a dead worker, it is published with
+ * SLOT_ABANDONED. Only called by the supervisor, after the claims of the dead workers
+ * were published and their sequence numbers made even.
+ * @param *ring - pointer to the circular buffer
+ * @return integer 1 if success, integer 0 if a worker claims right now
+ **/
+int ringRecover(Ring *ring) {
+    ShmObj *shm = ring->shm;
+    uint32_t seq[STATS_SIZE];
+    for (int i = 0; i < STATS_SIZE; i++) {
+        seq[i] = __atomic_load_n(&shm->stats[i].claim.seq, __ATOMIC_SEQ_CST);
+        if (seq[i] & 1) {
+            return 0;
+        }
+    }
+
+    uint32_t free = __atomic_load_n(&shm->freeSlots, __ATOMIC_SEQ_CST);
+    uint64_t write = __atomic_load_n(&shm->writePos, __ATOMIC_SEQ_CST);
+    Claim claims[STATS_SIZE];
+    for (int i = 0; i < STATS_SIZE; i++) {
+        claims[i].count = __atomic_load_n(&shm->stats[i].claim.count, __ATOMIC_SEQ_CST);
+        claims[i].pos = __atomic_load_n(&shm->stats[i].claim.pos, __ATOMIC_SEQ_CST);
+    }
+
+    for (int i = 0; i < STATS_SIZE; i++) {
+        if (__atomic_load_n(&shm->stats[i].claim.seq, __ATOMIC_SEQ_CST) != seq[i]) {
+            return 0;
+        }
+    }
+
+    // a worker clears its claim only after publishing, so a position missing from the
+    // claims read above is published by now or was never recorded
+    for (uint64_t pos = shm->readPos; pos < write; pos++) {
+        Slot *slot = ringSlot(ring, pos);
+        int claimed = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) == pos + 1;
+        for (int i = 0; !claimed && i < STATS_SIZE; i++) {
+            claimed = claims[i].count > 0 && pos >= claims[i].pos
+                      && pos - claims[i].pos < (uint64_t) claims[i].count;
+        }
+        if (!claimed) {
+            slot->length = 0;
+            slot->flags = SLOT_ABANDONED;
+            slot->origin = -1;
+            ringPublish(ring, pos, 1);
+        }
+    }
+
+    int64_t lost = (int64_t) shm->ringSize - free - (int64_t) (write - shm->readPos);
+    if (lost > 0) {
+        giveFree(shm, (int) lost);
+    }
+    return 1;
+}
+
+/**
+ * terminates the circular buffer
+ * @brief sets the terminate flag and wakes all generators waiting for a free slot.
+ * The extra free slot makes sure that a generator which checked the flag just before
+ * does not go to sleep, it claims the slot, sees the flag and gives it back.
+ * @param *ring - pointer to the circular buffer
+ **/
+void ringShutdown(Ring *ring) {
+    ShmObj *shm = ring->shm;
+    __atomic_store_n(&shm->terminate, 1, __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&shm->freeSlots, 1, __ATOMIC_SEQ_CST);
+    futexWake(&shm->freeSlots, INT_MAX);
+}
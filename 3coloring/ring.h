@@ -0,0 +1,56 @@
+/**
+ * @file ring.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Lock-free multi producer, single consumer circular buffer in the shared memory object.
+ *
+ **/
+
+#ifndef RING_H
+#define RING_H
+
+#include <stddef.h>
+#include <time.h>
+
+#include "structs.h"
+
+// Handle to the circular buffer
+// shm is the mapped shared memory object
+// spin is the number of polls before a waiting generator or supervisor sleeps in the kernel
+struct Ring {
+    ShmObj *shm;
+    int spin;
+};
+typedef struct Ring Ring;
+
+/**
+ * size from which the shared memory object is backed by huge pages if possible
+ * */
+#define RING_HUGEPAGE_SIZE (2 * 1024 * 1024)
+
+/**
+ * limits of the ring size and the solution size chosen by the supervisor
+ * */
+#define RING_MAX_SIZE (1 << 20)
+#define RING_MAX_SOLUTION_SIZE (1 << 16)
+
+/**
+ * default number of polls before sleeping, used on machines with more than one processor
+ * */
+#define RING_DEFAULT_SPIN 4000
+
+size_t ringObjectSize(int ringSize, int solutionSize);
+void ringInit(ShmObj *shm, int ringSize, int solutionSize, int spin);
+int ringDefaultSpin(void);
+void ringAdvise(void *memory, size_t size);
+int ringClaim(Ring *ring, int max, uint64_t *pos, Claim *claim);
+void ringUnclaim(Ring *ring, int count);
+Slot *ringSlot(Ring *ring, uint64_t pos);
+int ringPublish(Ring *ring, uint64_t pos, int count);
+int ringAcquire(Ring *ring, uint64_t *pos, const struct timespec *deadline);
+int ringRelease(Ring *ring, uint64_t pos);
+int ringRecover(Ring *ring);
+void ringShutdown(Ring *ring);
+
+#endif
@@ -0,0 +1,425 @@
+/**
+ * @file ringbench.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Benchmark for the circular buffer. Forks an increasing number of generator
+ * processes that publish a fixed solution as fast as possible while the parent reads
+ * them like the supervisor does, and prints the transferred solutions per second and,
+ * where the hardware counters are available, the cache misses per transferred solution.
+ * Every number of generators is measured with ring sizes 4, 16, 64, ... up to a maximum,
+ * optionally the reader stalls regularly like a busy supervisor.
+ * The Makefile builds the benchmark a second time as ringbench_packed with RING_PACKED,
+ * where the hot fields of the shared memory object and the slots are not padded to cache
+ * lines. With -u ringbench runs the same rounds in ringbench_packed afterwards, so the
+ * cache misses of both layouts are printed in one table.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "structs.h"
+#include "ring.h"
+
+/**
+ * Pointer to name of program
+ **/
+static char *program_name;
+
+/**
+ * number of edges of the published solutions
+ * */
+#define BENCH_SOLUTION_LENGTH 3
+
+/**
+ * name of the layout the benchmark was built with
+ * */
+#ifdef RING_PACKED
+#define BENCH_LAYOUT "packed"
+#else
+#define BENCH_LAYOUT "padded"
+#endif
+
+// Shared memory of the benchmark
+// shm is mapped with the size of the largest measured ring
+struct BenchShm {
+    ShmObj *shm;
+    size_t size;
+};
+typedef struct BenchShm BenchShm;
+
+// Result of one round, misses per solution is negative if no counter is available
+struct Round {
+    double rate;
+    double missesPerSolution;
+};
+typedef struct Round Round;
+
+/**
+ * printUsageError function.
+ * @brief Usage of program is printed to stderr and program is exited with failure code
+ * @details global variables: program_name, contains the name of the program
+ **/
+static void printUsageError(void) {
+
+    fprintf(stderr, "Usage: %s [-d MILLISECONDS] [-p MAX_GENERATORS] [-b BATCH] [-r MAX_RING_SIZE] [-l SOLUTION_SIZE] [-w STALL_MICROSECONDS] [-c SPIN] [-u]\n", program_name);
+    exit(EXIT_FAILURE);
+
+}
+
+/**
+ * returns the current time
+ * @return monotonic time in seconds
+ **/
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * generator process of the benchmark
+ * @brief publishes solutions with BENCH_SOLUTION_LENGTH edges in batches until terminate is set
+ * @param *ring - pointer to the circular buffer
+ * @param batch - maximum number of slots claimed at once
+ **/
+static void produce(Ring *ring, int batch) {
+    while (1) {
+        uint64_t pos;
+        int claimed = ringClaim(ring, batch, &pos, NULL);
+        if (claimed == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            _exit(EXIT_FAILURE);
+        }
+        if (claimed == 0) {
+            _exit(EXIT_SUCCESS);
+        }
+
+        if (__atomic_load_n(&ring->shm->terminate, __ATOMIC_ACQUIRE) == 1) {
+            ringUnclaim(ring, claimed);
+            _exit(EXIT_SUCCESS);
+        }
+
+        for (int j = 0; j < claimed; j++) {
+            Slot *slot = ringSlot(ring, pos + j);
+            slot->length = BENCH_SOLUTION_LENGTH;
+            for (int i = 0; i < BENCH_SOLUTION_LENGTH; i++) {
+                slot->edges[i].from = i;
+                slot->edges[i].to = i + 1;
+            }
+        }
+
+        ringPublish(ring, pos, claimed);
+    }
+}
+
+/**
+ * opens a hardware counter for cache misses
+ * @brief the counter also counts all children that are forked after it was opened,
+ * their counts are added when they exit
+ * @return file descriptor of the counter, integer -1 if the kernel or the machine
+ * does not provide the counter
+ **/
+static int openCacheMissCounter(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+/**
+ * runs one round of the benchmark
+ * @brief forks the generators, reads solutions for the given time and stops the generators.
+ * After every 1024 solutions the reader stalls for the given time.
+ * @param *bench - pointer to the shared memory of the benchmark
+ * @param generators - number of generator processes
+ * @param batch - maximum number of slots a generator claims at once
+ * @param ringSize - number of slots of the circular buffer
+ * @param solutionSize - maximum number of edges of a solution
+ * @param spin - number of polls before a wait sleeps
+ * @param duration - measured time in seconds
+ * @param stall - stall of the reader in microseconds
+ * @param *round - rate and cache misses of the round are written to it
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int runRound(BenchShm *bench, int generators, int batch, int ringSize, int solutionSize,
+                    int spin, double duration, long stall, Round *round) {
+    memset(bench->shm, 0, bench->size);
+    ringInit(bench->shm, ringSize, solutionSize, spin);
+
+    Ring ring = { bench->shm, spin };
+    if (batch > ringSize) {
+        batch = ringSize;
+    }
+
+    int counter = openCacheMissCounter();
+    if (counter != -1) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    for (int i = 0; i < generators; i++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            if (counter != -1) {
+                close(counter);
+            }
+            return -1;
+        } else if (pid == 0) {
+            produce(&ring, batch);
+        }
+    }
+
+    long solutions = 0;
+    double start = now();
+    double end = start + duration;
+    while (1) {
+        uint64_t pos;
+        if (ringAcquire(&ring, &pos, NULL) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        Slot *slot = ringSlot(&ring, pos);
+        if (slot->length != BENCH_SOLUTION_LENGTH || slot->edges[0].from != 0) {
+            fprintf(stderr, "%s: Corrupted solution at position %lu.\n", program_name, (unsigned long) pos);
+        }
+
+        ringRelease(&ring, pos);
+        solutions++;
+
+        if ((solutions & 1023) == 0) {
+            if (now() >= end) {
+                break;
+            }
+            if (stall > 0) {
+                usleep(stall);
+            }
+        }
+    }
+    double elapsed = now() - start;
+
+    ringShutdown(&ring);
+    while (wait(NULL) > 0) { }
+
+    round->rate = solutions / elapsed;
+    round->missesPerSolution = -1;
+    if (counter != -1) {
+        uint64_t misses;
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &misses, sizeof(misses)) == sizeof(misses) && solutions > 0) {
+            round->missesPerSolution = (double) misses / solutions;
+        }
+        close(counter);
+    }
+
+    return 1;
+}
+
+/**
+ * runs the same rounds with the packed layout
+ * @brief executes ringbench_packed from the directory of the benchmark with the same
+ * options and without the header line and waits for it
+ * @param *self - path of the benchmark
+ * @param *options - the options of the rounds, NULL terminated, options[0] is replaced
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int runPacked(const char *self, char **options) {
+    const char *slash = strrchr(self, '/');
+    size_t directory = slash != NULL ? (size_t) (slash - self + 1) : 0;
+    char *path = malloc(directory + sizeof("./ringbench_packed"));
+    if (path == NULL) {
+        return -1;
+    }
+    if (directory > 0) {
+        memcpy(path, self, directory);
+        strcpy(path + directory, "ringbench_packed");
+    } else {
+        strcpy(path, "./ringbench_packed");
+    }
+    options[0] = path;
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == -1) {
+        free(path);
+        return -1;
+    }
+    if (pid == 0) {
+        execv(path, options);
+        fprintf(stderr, "%s: Couldn't start %s.\n", program_name, path);
+        _exit(EXIT_FAILURE);
+    }
+    free(path);
+
+    int status;
+    if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * Program entry point.
+ * @brief The program starts here. Runs the benchmark for 1, 2, 4, ... generators
+ * up to the given maximum, each with ring sizes 4, 16, 64, ... up to the given maximum,
+ * and prints one line per round with the layout it was built with.
+ * -u runs the same rounds with the packed layout afterwards, -H leaves out the header line.
+ * @param argc The argument counter.
+ * @param argv The argument vector.
+ * @return Returns EXIT_SUCCESS or EXIT_FAILURE
+ **/
+int main(int argc, char *argv[]) {
+    program_name = argv[0];
+
+    long duration_ms = 250;
+    long max_generators = 16;
+    long batch = 1;
+    long max_ring_size = 4096;
+    long solution_size = DEFAULT_SOLUTION_SIZE;
+    long stall = 0;
+    long spin = ringDefaultSpin();
+    int compare = 0;
+    int header = 1;
+    char *endptr;
+
+    int option;
+    while ((option = getopt(argc, argv, "d:p:b:r:l:w:c:uH")) != -1) {
+        switch (option) {
+            case 'u':
+                compare = 1;
+                break;
+            case 'H':
+                header = 0;
+                break;
+            case 'd':
+                duration_ms = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || duration_ms <= 0) { printUsageError(); }
+                break;
+            case 'p':
+                max_generators = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || max_generators <= 0) { printUsageError(); }
+                break;
+            case 'b':
+                batch = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || batch <= 0 || batch > RING_MAX_SIZE) { printUsageError(); }
+                break;
+            case 'r':
+                max_ring_size = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || max_ring_size <= 0 || max_ring_size > RING_MAX_SIZE) { printUsageError(); }
+                break;
+            case 'l':
+                solution_size = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || solution_size < BENCH_SOLUTION_LENGTH
+                    || solution_size > RING_MAX_SOLUTION_SIZE) { printUsageError(); }
+                break;
+            case 'w':
+                stall = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || stall < 0) { printUsageError(); }
+                break;
+            case 'c':
+                spin = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || spin < 0 || spin > INT_MAX) { printUsageError(); }
+                break;
+            default:
+                printUsageError();
+        }
+    }
+    if (optind != argc) { printUsageError(); }
+
+    BenchShm bench;
+    bench.size = ringObjectSize(max_ring_size, solution_size);
+    bench.shm = mmap(NULL, bench.size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (bench.shm == MAP_FAILED) {
+        fprintf(stderr, "%s: Couldn't map shared memory.\n", program_name);
+        exit(EXIT_FAILURE);
+    }
+    ringAdvise(bench.shm, bench.size);
+
+    int exit_code = EXIT_SUCCESS;
+    if (header) {
+        fprintf(stdout, "layout,generators,batch,ring_size,spin,solutions_per_sec,cache_misses_per_solution\n");
+        fflush(stdout);
+    }
+    for (long generators = 1; generators <= max_generators && exit_code == EXIT_SUCCESS; generators *= 2) {
+        for (long ring_size = 4; exit_code == EXIT_SUCCESS; ring_size *= 4) {
+            if (ring_size > max_ring_size) {
+                ring_size = max_ring_size;
+            }
+
+            Round round;
+            if (runRound(&bench, generators, batch, ring_size, solution_size, spin,
+                         duration_ms / 1000.0, stall, &round) == -1) {
+                fprintf(stderr, "%s: Benchmark round failed.\n", program_name);
+                exit_code = EXIT_FAILURE;
+                break;
+            }
+            if (round.missesPerSolution < 0) {
+                fprintf(stdout, "%s,%ld,%ld,%ld,%ld,%.0f,n/a\n", BENCH_LAYOUT, generators, batch, ring_size,
+                        spin, round.rate);
+            } else {
+                fprintf(stdout, "%s,%ld,%ld,%ld,%ld,%.0f,%.2f\n", BENCH_LAYOUT, generators, batch, ring_size,
+                        spin, round.rate, round.missesPerSolution);
+            }
+            fflush(stdout);
+
+            if (ring_size == max_ring_size) {
+                break;
+            }
+        }
+    }
+
+    munmap(bench.shm, bench.size);
+
+    if (compare && exit_code == EXIT_SUCCESS) {
+        char values[7][24];
+        long settings[7] = { duration_ms, max_generators, batch, max_ring_size, solution_size, stall, spin };
+        const char *flags[7] = { "-d", "-p", "-b", "-r", "-l", "-w", "-c" };
+        char *options[17];
+        int length = 1;
+        for (int i = 0; i < 7; i++) {
+            snprintf(values[i], sizeof(values[i]), "%ld", settings[i]);
+            options[length++] = (char *) flags[i];
+            options[length++] = values[i];
+        }
+        options[length++] = "-H";
+        options[length] = NULL;
+
+        if (runPacked(argv[0], options) == -1) {
+            fprintf(stderr, "%s: Packed layout couldn't be measured.\n", program_name);
+            exit_code = EXIT_FAILURE;
+        }
+    }
+
+    exit(exit_code);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file rng.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Rng module. Every generator gets its own stream of a xoshiro256** generator.
+ * All streams start from the same seed and are 2^128 numbers apart, so they never
+ * overlap and a run with the same seed and the same streams is reproducible.
+ *
+ **/
+
+#include "rng.h"
+
+/**
+ * next value of a splitmix64 generator, used to expand the seed
+ * @param *state - state of the splitmix64 generator
+ * @return 64 bit value
+ **/
+static uint64_t splitMix(uint64_t *state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * advances the generator by 2^128 numbers
+ * @param *rng - pointer to the generator
+ **/
+static void rngJump(Rng *rng) {
+    static const uint64_t jump[] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+    uint64_t s[4] = { 0, 0, 0, 0 };
+
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (jump[i] & (1ULL << b)) {
+                for (int k = 0; k < 4; k++) {
+                    s[k] ^= rng->s[k];
+                }
+            }
+            rngNext(rng);
+        }
+    }
+
+    for (int k = 0; k < 4; k++) {
+        rng->s[k] = s[k];
+    }
+}
+
+/**
+ * seeds the generator
+ * @brief expands the seed with splitmix64 and jumps to the start of the stream
+ * @param *rng - pointer to the generator
+ * @param seed - seed of the run
+ * @param stream - number of the stream
+ **/
+void rngSeed(Rng *rng, uint64_t seed, uint64_t stream) {
+    for (int k = 0; k < 4; k++) {
+        rng->s[k] = splitMix(&seed);
+    }
+
+    for (uint64_t i = 0; i < stream; i++) {
+        rngJump(rng);
+    }
+}
+
+/**
+ * fills an array with random colors between 0 and 2
+ * @brief every 32 bits give ten colors: multiplying with 3 moves the next color into the
+ * upper half and keeps the remaining bits, which stay uniform because 3 is odd
+ * @param *rng - pointer to the generator
+ * @param *colors - the array
+ * @param length - number of colors
+ **/
+static void rngColors3(Rng *rng, uint8_t *colors, int length) {
+    int v = 0;
+    while (v < length) {
+        uint64_t bits = rngNext(rng);
+
+        for (int half = 0; half < 2; half++) {
+            uint32_t x = (uint32_t) (bits >> (32 * half));
+
+            for (int d = 0; d < 10 && v < length; d++) {
+                uint64_t y = (uint64_t) x * 3;
+                colors[v++] = (uint8_t) (y >> 32);
+                x = (uint32_t) y;
+            }
+        }
+    }
+}
+
+/**
+ * defines a function that fills an array with random colors below 2^WIDTH
+ * @brief every color takes WIDTH bits of a random number, so one number gives
+ * 64 / WIDTH colors without any multiplication
+ **/
+#define RNG_COLORS_PACKED(NAME, WIDTH) \
+    static void NAME(Rng *rng, uint8_t *colors, int length) { \
+        int v = 0; \
+        while (v < length) { \
+            uint64_t bits = rngNext(rng); \
+            for (int d = 0; d < 64 / (WIDTH) && v < length; d++) { \
+                colors[v++] = (uint8_t) (bits & ((1u << (WIDTH)) - 1)); \
+                bits >>= (WIDTH); \
+            } \
+        } \
+    }
+
+RNG_COLORS_PACKED(rngColors4, 2)
+RNG_COLORS_PACKED(rngColors8, 3)
+
+/**
+ * fills an array with random colors
+ * @brief 3, 4 and 8 colors have functions of their own, any other number of colors
+ * takes one random number per color
+ * @param *rng - pointer to the generator
+ * @param *colors - the array
+ * @param length - number of colors
+ * @param count - number of colors to choose from, between 1 and 256
+ **/
+void rngColors(Rng *rng, uint8_t *colors, int length, int count) {
+    switch (count) {
+        case 3:
+            rngColors3(rng, colors, length);
+            break;
+        case 4:
+            rngColors4(rng, colors, length);
+            break;
+        case 8:
+            rngColors8(rng, colors, length);
+            break;
+        default:
+            for (int v = 0; v < length; v++) {
+                colors[v] = (uint8_t) rngBelow(rng, count);
+            }
+    }
+}
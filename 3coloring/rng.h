@@ -0,0 +1,66 @@
+/**
+ * @file rng.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Contains structs and the inline generator functions for rng.c
+ *
+ **/
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// State of a xoshiro256** pseudo random number generator
+struct Rng {
+    uint64_t s[4];
+};
+typedef struct Rng Rng;
+
+void rngSeed(Rng *rng, uint64_t seed, uint64_t stream);
+void rngColors(Rng *rng, uint8_t *colors, int length, int count);
+
+/**
+ * rotates a 64 bit value to the left
+ * @param x - the value
+ * @param k - number of bits, between 1 and 63
+ * @return the rotated value
+ **/
+static inline uint64_t rngRotate(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * returns the next 64 random bits
+ * @param *rng - pointer to the generator
+ * @return uniformly distributed 64 bit value
+ **/
+static inline uint64_t rngNext(Rng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rngRotate(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rngRotate(s[3], 45);
+
+    return result;
+}
+
+/**
+ * returns a random number below a limit
+ * @brief multiplies the upper 32 bits with the limit instead of using modulo, the
+ * upper bits of xoshiro256** are the best ones
+ * @param *rng - pointer to the generator
+ * @param limit - upper limit, greater than zero
+ * @return number between 0 and limit - 1
+ **/
+static inline uint32_t rngBelow(Rng *rng, uint32_t limit) {
+    return (uint32_t) (((rngNext(rng) >> 32) * limit) >> 32);
+}
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file stats.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Stats module. The supervisor samples the counters the generators keep in the
+ * shared memory object and prints the rates between two samples. The contention is the
+ * part of the time the generators waited for free slots: close to 0 means the supervisor
+ * keeps up and more generators help, close to 1 means the supervisor is the bottleneck.
+ * The sums cover every worker that ever ran, so the rates stay right when workers exit,
+ * only the number of generators and the contention count the active ones.
+ *
+ **/
+
+#include <time.h>
+
+#include "stats.h"
+
+/**
+ * takes a sample of the counters
+ * @param *shm - pointer to the shared memory object
+ * @param read - number of solutions the supervisor read so far
+ * @param *sample - the sample is written to it
+ **/
+void statsSample(ShmObj *shm, uint64_t read, StatsSample *sample) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    sample->time = ts.tv_sec + ts.tv_nsec / 1e9;
+    sample->generators = 0;
+    sample->best = -1;
+    sample->attempts = 0;
+    sample->published = 0;
+    sample->blocked = 0;
+    sample->read = read;
+    sample->occupancy = __atomic_load_n(&shm->writePos, __ATOMIC_RELAXED) - shm->readPos;
+
+    for (int i = 0; i < STATS_SIZE; i++) {
+        Stats *stats = &shm->stats[i];
+        if (__atomic_load_n(&stats->pid, __ATOMIC_ACQUIRE) == 0) {
+            continue;
+        }
+
+        int best = __atomic_load_n(&stats->best, __ATOMIC_RELAXED);
+        sample->generators += __atomic_load_n(&stats->owner, __ATOMIC_ACQUIRE) != 0;
+        if (best != -1 && (sample->best == -1 || best < sample->best)) {
+            sample->best = best;
+        }
+        sample->attempts += __atomic_load_n(&stats->attempts, __ATOMIC_RELAXED);
+        sample->published += __atomic_load_n(&stats->published, __ATOMIC_RELAXED);
+        sample->blocked += __atomic_load_n(&stats->blocked, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * prints the rates between two samples in one line
+ * @param *file - the line is printed to it
+ * @param *shm - pointer to the shared memory object
+ * @param *previous - earlier sample
+ * @param *current - later sample
+ **/
+void statsPrint(FILE *file, ShmObj *shm, const StatsSample *previous, const StatsSample *current) {
+    double elapsed = current->time - previous->time;
+    if (elapsed <= 0) {
+        return;
+    }
+
+    double contention = 0;
+    if (current->generators > 0) {
+        contention = (current->blocked - previous->blocked) / (elapsed * 1e9 * current->generators);
+    }
+
+    fprintf(file, "stats: %d generator(s), %.0f attempts/s, %.0f published/s, %.0f read/s, "
+            "ring %lu/%d, contention %.3f, best %d\n",
+            current->generators,
+            (current->attempts - previous->attempts) / elapsed,
+            (current->published - previous->published) / elapsed,
+            (current->read - previous->read) / elapsed,
+            (unsigned long) current->occupancy, shm->ringSize,
+            contention, current->best);
+}
+
+/**
+ * prints the counters of all generators as one JSON object
+ * @brief every block of counters is listed with the last worker that held it, blocks
+ * that are free again are listed with active false
+ * @param *file - the object is printed to it
+ * @param *shm - pointer to the shared memory object
+ * @param *first - sample taken at the start of the supervisor
+ * @param *last - sample taken at the end of the supervisor
+ **/
+void statsDump(FILE *file, ShmObj *shm, const StatsSample *first, const StatsSample *last) {
+    fprintf(file, "{\"elapsed\":%.3f,\"ring_size\":%d,\"solution_size\":%d,\"read\":%lu,"
+            "\"attempts\":%lu,\"published\":%lu,\"blocked_ns\":%lu,\"best\":%d,\"generators\":[",
+            last->time - first->time, shm->ringSize, shm->solutionSize,
+            (unsigned long) last->read, (unsigned long) last->attempts,
+            (unsigned long) last->published, (unsigned long) last->blocked, last->best);
+
+    int printed = 0;
+    for (int i = 0; i < STATS_SIZE; i++) {
+        Stats *stats = &shm->stats[i];
+        if (__atomic_load_n(&stats->pid, __ATOMIC_ACQUIRE) == 0) {
+            continue;
+        }
+        fprintf(file, "%s{\"stream\":%d,\"pid\":%d,\"active\":%s,\"attempts\":%lu,\"published\":%lu,"
+                "\"blocked_ns\":%lu,\"best\":%d}",
+                printed++ > 0 ? "," : "", stats->stream, stats->pid,
+                __atomic_load_n(&stats->owner, __ATOMIC_ACQUIRE) != 0 ? "true" : "false",
+                (unsigned long) __atomic_load_n(&stats->attempts, __ATOMIC_RELAXED),
+                (unsigned long) __atomic_load_n(&stats->published, __ATOMIC_RELAXED),
+                (unsigned long) __atomic_load_n(&stats->blocked, __ATOMIC_RELAXED),
+                __atomic_load_n(&stats->best, __ATOMIC_RELAXED));
+    }
+    fprintf(file, "]}\n");
+}
@@ -0,0 +1,39 @@
+/**
+ * @file stats.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Reports of the supervisor about the counters of the generators.
+ *
+ **/
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+
+#include "structs.h"
+
+// Sum of the counters of all generators at one point in time
+// time is the monotonic time in seconds, generators the number of active workers,
+// the counters are summed over all workers that ever ran
+// read is the number of solutions the supervisor read, occupancy the number of
+// claimed but not yet read slots
+// best is the smallest number of edges published by any worker, -1 if none
+struct StatsSample {
+    double time;
+    int generators;
+    int best;
+    uint64_t attempts;
+    uint64_t published;
+    uint64_t blocked;
+    uint64_t read;
+    uint64_t occupancy;
+};
+typedef struct StatsSample StatsSample;
+
+void statsSample(ShmObj *shm, uint64_t read, StatsSample *sample);
+void statsPrint(FILE *file, ShmObj *shm, const StatsSample *previous, const StatsSample *current);
+void statsDump(FILE *file, ShmObj *shm, const StatsSample *first, const StatsSample *last);
+
+#endif
@@ -10,25 +10,22 @@
 #ifndef STRUCTS_H
 #define STRUCTS_H
 
-/**
- * semaphore that indicates free space
- * */
-#define SEM_FREE "/11808237_sem_free"
+#include <stdint.h>
 
 /**
- * semaphore that indicates used space
+ * shared memory for circular buffer
  * */
-#define SEM_USED "/11808237_sem_used"
+#define SHM "/11808237_shm"
 
 /**
- * semaphore for write access
+ * read only shared memory for the graph of the supervisor
  * */
-#define SEM_WRITE "/11808237_sem_write"
+#define SHM_GRAPH "/11808237_shm_graph"
 
 /**
- * shared memory for circular buffer
+ * shared memory for the elite colorings of the local search generators
  * */
-#define SHM "/11808237_shm"
+#define SHM_ELITE "/11808237_shm_elite"
 
 // Representation of an Edge, with two integer values for vertex index
 struct Edge {
@@ -37,16 +34,174 @@ struct Edge {
 };
 typedef struct Edge Edge;
 
-// Representation of an Shared Memory Object
+// Defines an array of edges, length indicates the current size of the array
+struct EdgeArray {
+    int length;
+    Edge *content;
+};
+typedef struct EdgeArray EdgeArray;
+
+/**
+ * size of a cache line, fields written by different processes are kept on different lines
+ * */
+#define CACHE_LINE 64
+
+/**
+ * alignment of the hot fields of the shared memory object and of the slots, ringbench
+ * builds a second variant with RING_PACKED that keeps the layout without the padding
+ * */
+#ifdef RING_PACKED
+#define RING_ALIGN 8
+#else
+#define RING_ALIGN CACHE_LINE
+#endif
+
+/**
+ * default number of slots in the circular buffer
+ * */
+#define DEFAULT_RING_SIZE 50
+
+/**
+ * default maximum number of edges in one solution
+ * */
+#define DEFAULT_SOLUTION_SIZE 8
+
+/**
+ * default number of colors of a coloring
+ * */
+#define DEFAULT_COLORS 3
+
+/**
+ * maximum number of colors of a coloring
+ * */
+#define MAX_COLORS 16
+
+/**
+ * flag of a slot the supervisor published for a generator that died after claiming it
+ * */
+#define SLOT_ABANDONED 2
+
+/**
+ * maximum number of parts of the graph of the supervisor, see preprocess.h
+ * */
+#define MAX_PARTS 64
+
+/**
+ * flag of a slot without edges, no solution with less than length edges exists
+ * */
+#define SLOT_PROVEN 1
+
+// One slot of the circular buffer, slots are solutionSize edges long
+// seq is the sequence number of the slot: a generator that claimed position pos
+// publishes the slot by setting seq to pos + 1, the supervisor frees it again by
+// setting seq to pos + ringSize
+// length is the number of edges of the solution, only these entries of edges are valid
+// flags is 0 for a solution, SLOT_PROVEN or SLOT_ABANDONED
+// part is the part of the graph of the supervisor the solution belongs to, its edges
+// are numbered like the part, -1 for a solution of the whole graph in the original numbering
+// origin is the random number stream of the worker that published the slot, -1 if unknown
+struct Slot {
+    uint64_t seq;
+    int length;
+    int flags;
+    int part;
+    int origin;
+    Edge edges[];
+};
+typedef struct Slot Slot;
+
+/**
+ * number of generator workers with their own counters
+ * */
+#define STATS_SIZE 64
+
+// Slots a generator worker claims, only written by the worker while it runs
+// seq is odd while the worker takes free slots and claims their positions, so the
+// supervisor knows when no worker holds free slots without a position
+// count slots from pos on are claimed by the worker and not published yet, the
+// supervisor publishes them if the worker dies
+struct Claim {
+    uint32_t seq;
+    int count;
+    uint64_t pos;
+};
+typedef struct Claim Claim;
+
+// Counters of the generator workers, only written by the worker that holds them with
+// relaxed atomics
+// owner is the process that holds the block, 0 if it is free, a worker takes a free block
+// with a compare and swap and gives it back when it exits, the supervisor takes the blocks
+// of dead generators back, pid and stream are the process and the random number stream
+// of the last worker, pid is 0 if the block was never used
+// best is the smallest number of edges published with the block, -1 before the first one
+// attempts counts random colorings or local search moves, published the solutions
+// written to the buffer, the counters are kept when the block is taken again
+// blocked is the time in nanoseconds the workers waited for free slots
+// claim holds the slots the worker claimed and did not publish yet
+struct Stats {
+    int owner;
+    int pid;
+    int stream;
+    int best;
+    uint64_t attempts;
+    uint64_t published;
+    uint64_t blocked;
+    Claim claim;
+} __attribute__((aligned(CACHE_LINE)));
+typedef struct Stats Stats;
+
+// Representation of an Shared Memory Object, its size is chosen by the supervisor
 // terminate indicates when functions should terminate
-// write position is the current index of the write position, used by generators
-// read position is the current pointer to the read position
-// edge contains max. 50 solutions with eight edges each
+// best bound is the number of edges of the best solution of the supervisor, generators
+// only publish solutions with less edges, it starts with solutionSize + 1
+// parts is the number of parts of the graph of the supervisor, 0 without a graph, every
+// generator takes part next part modulo parts with an atomic increment, part bound
+// is the best bound of every part
+// color count is the number of colors of the colorings, the same for every generator
+// seed is the seed of the run, next stream is the random number stream of the next
+// generator, every generator takes one with an atomic increment
+// ring size is the number of slots, solution size the maximum number of edges of a
+// solution, spin the number of polls before a wait sleeps in the kernel, slot size the
+// distance between two slots in bytes and size the size of the whole object, these are
+// written once by the supervisor, size last
+// owner is the process of the supervisor, it is written first, so the next supervisor of
+// the same instance can tell if the object was left behind by a crashed run
+// write position is the next position claimed by a generator, it is only ever
+// incremented atomically and never wraps, the slot index is writePos % ringSize
+// free slots is the number of slots the generators may still claim, generators that
+// wait for it count themselves in free waiters and sleep on free slots
+// read position is the next position read by the supervisor
+// used seq is the doorbell of the supervisor, it sleeps on it while consumer waiting
+// is set and generators increment it after publishing
+// stats holds the counters of the running workers, at most STATS_SIZE workers run at once
+// data contains ringSize slots, every slot starts on a cache line, so two generators
+// never write to the same line
+// the fields above write position are read by everyone and rarely written, write position
+// and the free slot words are written by the generators, read position and the doorbell
+// by the supervisor, each of these groups gets its own cache line
 struct ShmObj {
     int terminate;
-    int writePos;
-    int readPos;
-    Edge data[50][8];
+    int bestBound;
+    uint64_t seed;
+    uint64_t nextStream;
+    int colorCount;
+    int parts;
+    int nextPart;
+    int partBound[MAX_PARTS];
+    int ringSize;
+    int solutionSize;
+    int spin;
+    size_t slotSize;
+    size_t size;
+    int owner;
+    uint64_t writePos __attribute__((aligned(RING_ALIGN)));
+    uint32_t freeSlots;
+    uint32_t freeWaiters;
+    uint64_t readPos __attribute__((aligned(RING_ALIGN)));
+    uint32_t usedSeq;
+    uint32_t consumerWaiting;
+    Stats stats[STATS_SIZE];
+    unsigned char data[] __attribute__((aligned(RING_ALIGN)));
 };
 typedef struct ShmObj ShmObj;
 
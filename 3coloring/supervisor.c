@@ -14,17 +14,43 @@
 #include <signal.h>
 #include <unistd.h>
 #include <sys/types.h>
-#include <semaphore.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <time.h>
+#include <sys/time.h>
+#include <limits.h>
 #include "structs.h"
+#include "ring.h"
+#include "graph.h"
+#include "stats.h"
+#include "preprocess.h"
+#include "launcher.h"
+#include "affinity.h"
+#include "elite.h"
+#include "instance.h"
 
 /**
  * indicates if supervisor should terminate
  **/
 volatile sig_atomic_t quit = 0;
 
+/**
+ * indicates if supervisor should print the stats
+ **/
+volatile sig_atomic_t report = 0;
+
+/**
+ * indicates if a generator started by the supervisor exited
+ **/
+volatile sig_atomic_t children = 0;
+
+/**
+ * indicates if the time limit of the run is over
+ **/
+volatile sig_atomic_t expired = 0;
+
 /**
  * Pointer to name of program
  **/
@@ -37,7 +63,8 @@ static char *program_name;
  **/
 static void printUsageError(void) {
 
-    fprintf(stderr, "Usage: %s\n", program_name);
+    fprintf(stderr, "Usage: %s [-s SEED] [-g GRAPHFILE] [-k COLORS] [-r RINGSIZE] [-l SOLUTIONSIZE] [-c SPIN] [-i INTERVAL] [-p PARTS] "
+            "[-t TIMELIMIT] [-e TARGET] [-o TRACEFILE] [-I INSTANCE] [-j WORKERS [-n] [-- GENERATOR ARGS...]]\n", program_name);
     exit(EXIT_FAILURE);
 
 }
@@ -61,11 +88,344 @@ static void handle_signal(int signal) {
 
 }
 
+/**
+ * handles SIGALRM signals.
+ * @brief sets the global var report to 1, so the stats are printed
+ * @param signal, the signal that should be handed
+ * @details global variables: report
+ **/
+static void handle_alarm(int signal) {
+
+    (void) signal;
+    report = 1;
+
+}
+
+/**
+ * handles SIGUSR1 signals of the time limit timer.
+ * @brief sets the global var expired to 1, so the run ends
+ * @param signal, the signal that should be handed
+ * @details global variables: expired
+ **/
+static void handle_deadline(int signal) {
+
+    (void) signal;
+    expired = 1;
+
+}
+
+/**
+ * handles SIGCHLD signals.
+ * @brief sets the global var children to 1, so the exited generators are collected
+ * @param signal, the signal that should be handed
+ * @details global variables: children
+ **/
+static void handle_child(int signal) {
+
+    (void) signal;
+    children = 1;
+
+}
+
+/**
+ * returns the seconds since a start time
+ * @param *start - the start time on the monotonic clock
+ * @return elapsed time in seconds
+ **/
+static double elapsed(const struct timespec *start) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec - start->tv_sec) + (ts.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/**
+ * writes an improvement to the convergence trace
+ * @param *trace - the trace file or NULL
+ * @param *start - the start time of the run
+ * @param length - number of edges of the new best solution
+ * @param origin - stream of the worker that found it, -1 for the preprocessing
+ **/
+static void traceImprovement(FILE *trace, const struct timespec *start, int length, int origin) {
+    if (trace == NULL) {
+        return;
+    }
+    fprintf(trace, "%.6f,%d,%d\n", elapsed(start), length, origin);
+    fflush(trace);
+}
+
+/**
+ * loads the graph for the generators
+ * @brief reads the edges from the file, preprocesses them and builds the parts in the
+ * read only shared memory object of the graph
+ * @param *path - path of the graph file
+ * @param parts - maximum number of parts
+ * @param colorCount - number of colors
+ * @param *graph_name - name of the shared memory object of the graph
+ * @param *elite_name - name of the shared memory object of the elite colorings
+ * @param *pre - the preprocessing result
+ * @return integer 1 if success, integer -1 if failure
+ **/
+static int loadGraph(const char *path, int parts, int colorCount, const char *graph_name, const char *elite_name, Preprocess *pre) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "%s: Couldn't open graph file %s.\n", program_name, path);
+        return -1;
+    }
+
+    EdgeArray edges;
+    int read_status = graphRead(file, &edges);
+    fclose(file);
+    if (read_status == -1 || edges.length == 0) {
+        fprintf(stderr, "%s: Graph file %s couldn't be parsed.\n", program_name, path);
+        free(edges.content);
+        return -1;
+    }
+
+    int preprocessed = preprocessGraph(pre, edges.content, edges.length, parts, colorCount);
+    free(edges.content);
+    if (preprocessed == -1) {
+        fprintf(stderr, "%s: Couldn't preprocess the graph.\n", program_name);
+        return -1;
+    }
+    fprintf(stderr, "%s: %d of %d vertices peeled, %d component(s) in %d part(s).\n",
+            program_name, pre->peeled, pre->vertices, pre->components, pre->parts);
+
+    // the run owns the instance, objects of the same name are left from a crashed run
+    shm_unlink(graph_name);
+    if (graphCreateShared(graph_name, pre->edges, pre->parts) == -1) {
+        fprintf(stderr, "%s: Couldn't create shared memory for the graph.\n", program_name);
+        preprocessFree(pre);
+        return -1;
+    }
+
+    // local search generators run without exchange if the pool is missing
+    int vertices[MAX_PARTS];
+    for (int p = 0; p < pre->parts; p++) {
+        vertices[p] = pre->originalStart[p + 1] - pre->originalStart[p];
+    }
+    shm_unlink(elite_name);
+    if (eliteCreateShared(elite_name, vertices, pre->parts) == -1) {
+        fprintf(stderr, "%s: Couldn't create shared memory for the elite colorings.\n", program_name);
+    }
+    return 1;
+}
+
+/**
+ * checks if a shared memory object was left behind by a crashed run
+ * @brief the object is stale if its supervisor no longer exists. An object that is too
+ * small to hold the owner is stale once it is older than INSTANCE_STALE_AGE seconds,
+ * before that its supervisor may still be initializing it.
+ * @param *name - name of the shared memory object
+ * @return integer 1 if stale or already removed, integer 0 otherwise
+ **/
+static int isStale(const char *name) {
+    int shmfd = shm_open(name, O_RDONLY, 0);
+    if (shmfd == -1) {
+        return errno == ENOENT;
+    }
+
+    struct stat st;
+    if (fstat(shmfd, &st) == -1) {
+        close(shmfd);
+        return 0;
+    }
+    if ((size_t) st.st_size < sizeof(ShmObj)) {
+        close(shmfd);
+        return time(NULL) - st.st_mtime > INSTANCE_STALE_AGE;
+    }
+
+    ShmObj *shm_obj = mmap(NULL, sizeof(ShmObj), PROT_READ, MAP_SHARED, shmfd, 0);
+    close(shmfd);
+    if (shm_obj == MAP_FAILED) {
+        return 0;
+    }
+    pid_t owner = __atomic_load_n(&shm_obj->owner, __ATOMIC_ACQUIRE);
+    munmap(shm_obj, sizeof(ShmObj));
+    return owner > 0 && kill(owner, 0) == -1 && errno == ESRCH;
+}
+
+/**
+ * creates the shared memory object of the run
+ * @brief the object is created exclusively, so only one supervisor runs per instance.
+ * If the object exists but is stale it is removed together with the graph and the elite
+ * colorings of the crashed run and created again.
+ * @param *shm_name - name of the shared memory object
+ * @param *graph_name - name of the shared memory object of the graph
+ * @param *elite_name - name of the shared memory object of the elite colorings
+ * @return the file descriptor, integer -1 if failure
+ **/
+static int createShm(const char *shm_name, const char *graph_name, const char *elite_name) {
+    int shmfd = shm_open(shm_name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (shmfd != -1 || errno != EEXIST || !isStale(shm_name)) {
+        return shmfd;
+    }
+
+    fprintf(stderr, "%s: Removing shared memory %s of a crashed run.\n", program_name, shm_name);
+    shm_unlink(shm_name);
+    shm_unlink(graph_name);
+    shm_unlink(elite_name);
+    return shm_open(shm_name, O_RDWR | O_CREAT | O_EXCL, 0600);
+}
+
+/**
+ * writes the bounds of the generators
+ * @brief a part is bounded by the best solutions of its components, the whole solution
+ * by all of them, no bound is above solution size + 1
+ * @param *shm_obj - the shared memory object
+ * @param *pre - the preprocessing result
+ * @param solution_size - maximum number of edges of a solution
+ **/
+static void updateBounds(ShmObj *shm_obj, const Preprocess *pre, int solution_size) {
+    for (int p = 0; p < pre->parts; p++) {
+        int bound = pre->partLength[p] <= solution_size ? pre->partLength[p] : solution_size + 1;
+        __atomic_store_n(&shm_obj->partBound[p], bound, __ATOMIC_RELAXED);
+    }
+    int bound = pre->length <= solution_size ? pre->length : solution_size + 1;
+    __atomic_store_n(&shm_obj->bestBound, bound, __ATOMIC_RELAXED);
+}
+
+/**
+ * takes the counters of dead generators back
+ * @brief the slots a dead worker claimed are marked SLOT_ABANDONED, so the supervisor
+ * reads past them instead of waiting forever. Slots the worker published before it died
+ * are kept. The sequence number of a claim the worker left odd is made even again and the
+ * block is free for the next worker. Only blocks of processes that are gone are taken, a
+ * generator the supervisor started is gone once it was reaped.
+ * @param *ring - pointer to the circular buffer
+ * @return integer 1 if a worker died while claiming, integer 0 otherwise
+ **/
+static int recoverStats(Ring *ring) {
+    ShmObj *shm = ring->shm;
+    int lost = 0;
+    for (int i = 0; i < STATS_SIZE; i++) {
+        Stats *stats = &shm->stats[i];
+        pid_t owner = __atomic_load_n(&stats->owner, __ATOMIC_ACQUIRE);
+        if (owner == 0 || kill(owner, 0) == 0 || errno != ESRCH) {
+            continue;
+        }
+
+        Claim *claim = &stats->claim;
+        int count = __atomic_load_n(&claim->count, __ATOMIC_ACQUIRE);
+        uint64_t pos = __atomic_load_n(&claim->pos, __ATOMIC_RELAXED);
+        for (int j = 0; j < count; j++) {
+            Slot *slot = ringSlot(ring, pos + j);
+            if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos + j + 1) {
+                slot->length = 0;
+                slot->flags = SLOT_ABANDONED;
+                slot->origin = -1;
+                ringPublish(ring, pos + j, 1);
+            }
+        }
+        __atomic_store_n(&claim->count, 0, __ATOMIC_RELAXED);
+
+        uint32_t seq = __atomic_load_n(&claim->seq, __ATOMIC_RELAXED);
+        if (seq & 1) {
+            __atomic_store_n(&claim->seq, seq + 1, __ATOMIC_SEQ_CST);
+            lost = 1;
+        }
+        __atomic_store_n(&stats->owner, 0, __ATOMIC_RELEASE);
+    }
+    return lost;
+}
+
+/**
+ * collects the exited generators and restarts the ones that died
+ * @brief a generator that exited with success is done, one that died during the run is
+ * restarted unless it died within LAUNCHER_MIN_RUNTIME seconds after its start
+ * @param *launcher - the generators
+ * @param *ring - pointer to the circular buffer
+ * @param restart - integer 1 if dead generators are restarted
+ * @return integer 1 if a worker died while claiming, integer 0 otherwise
+ **/
+static int reapGenerators(Launcher *launcher, Ring *ring, int restart) {
+    pid_t pid;
+    int failed;
+    double runtime;
+    int index;
+    int lost = 0;
+    while ((index = launcherReap(launcher, &pid, &failed, &runtime)) != -1) {
+        lost |= recoverStats(ring);
+        if (!failed || !restart) {
+            continue;
+        }
+        if (runtime < LAUNCHER_MIN_RUNTIME) {
+            fprintf(stderr, "%s: Generator %d died after %.2f s, it is not restarted.\n",
+                    program_name, index, runtime);
+        } else if (launcherStart(launcher, index) == -1) {
+            fprintf(stderr, "%s: Couldn't restart generator %d.\n", program_name, index);
+        } else {
+            fprintf(stderr, "%s: Generator %d died, restarted.\n", program_name, index);
+        }
+    }
+    return lost;
+}
+
+/**
+ * prints a solution
+ * @brief with a graph the self loops and the best solutions of all components are
+ * printed, otherwise the edges of the slot
+ * @param *pre - the preprocessing result or NULL
+ * @param *slot - the slot of the solution
+ * @param length - number of edges of the solution
+ **/
+static void printSolution(const Preprocess *pre, const Slot *slot, int length) {
+    fprintf(stdout, "Solution with %d edge(s):", length);
+
+    if (pre == NULL) {
+        for (int i = 0; i < length; i++) {
+            fprintf(stdout, " %d-%d", slot->edges[i].from, slot->edges[i].to);
+        }
+    } else {
+        for (int i = 0; i < pre->forced.length; i++) {
+            fprintf(stdout, " %d-%d", pre->forced.content[i].from, pre->forced.content[i].to);
+        }
+        for (int c = 0; c < pre->components; c++) {
+            for (int i = 0; i < pre->best[c].length; i++) {
+                fprintf(stdout, " %d-%d", pre->best[c].content[i].from, pre->best[c].content[i].to);
+            }
+        }
+    }
+
+    fprintf(stdout, "\n");
+    fflush(stdout);
+}
 
 /**
  * Program entry point.
  * @brief The program starts here. This function takes care about parameters.
- * Then it creates the shared memory and semaphores. After initialization the
+ * -k sets the number of colors of the colorings, default 3, the generators take it from
+ * the shared memory object.
+ * With -g the graph is loaded once from a file and shared with all generators. Vertices
+ * with less neighbours than colors are peeled, the rest is split into connected components
+ * and -p spreads them over at most PARTS parts, default 1. Every generator takes the next
+ * part, the best solutions of the components are merged to the solution of the graph.
+ * Solutions of generators that loaded a graph of their own are ignored with -g.
+ * The greedy coloring of the preprocessing is the first solution.
+ * -s sets the seed of the run, without it the seed is taken from the time and process id.
+ * -r sets the number of slots of the circular buffer and -l the maximum number of edges
+ * of a solution, the shared memory object is sized from both.
+ * -c sets how often the supervisor and the generators poll the circular buffer before
+ * they sleep, default 0 on machines with one processor and RING_DEFAULT_SPIN otherwise.
+ * A generator with the exact engine ends the run when its search proves that the best
+ * solution is optimal.
+ * -i prints the rates of the generators every INTERVAL seconds to stderr and all counters
+ * as JSON object when the supervisor terminates.
+ * -t ends the run after TIMELIMIT seconds and -e as soon as a solution with at most TARGET
+ * edges is found, both through the terminate flag like SIGINT and SIGTERM.
+ * -I runs the supervisor in its own instance, by default the instance is taken from
+ * INSTANCE_ENV. The names of all shared memory objects end with the instance, so runs of
+ * different instances with their own ring and solution sizes share a host. The started
+ * generators inherit the instance. Objects of the instance that a crashed run left
+ * behind are removed.
+ * -o writes the convergence trace to TRACEFILE, one CSV line per new best solution with
+ * the seconds since the start, its number of edges and the stream of the worker that
+ * found it, -1 for the greedy coloring of the preprocessing.
+ * -j starts WORKERS generators with the arguments after --, each one pinned to its own
+ * processor. Generators that die are restarted, all of them end through the terminate
+ * flag with the run. With -n the supervisor pins itself to its first processor before it
+ * creates the shared memory, so its pages are placed on that NUMA node, and the generators
+ * take the processors of the same node first.
+ * Then it creates the shared memory. After initialization the
  * program waits for solutions from the generators and handles the results.
  * global variables: program_name, quit
  * @param argc The argument counter.
@@ -74,66 +434,192 @@ static void handle_signal(int signal) {
 int main( int argc, char *argv[] ) {
     program_name = argv[0];
 
-    if (argc != 1) {
+    char *graph_path = NULL;
+    uint64_t seed = (uint64_t) time(NULL) ^ ((uint64_t) getpid() << 32);
+    long ring_size = DEFAULT_RING_SIZE;
+    long solution_size = DEFAULT_SOLUTION_SIZE;
+    long spin = ringDefaultSpin();
+    double interval = 0;
+    long parts = 1;
+    long color_count = DEFAULT_COLORS;
+    long jobs = 0;
+    int numa = 0;
+    double time_limit = 0;
+    long target = -1;
+    char *trace_path = NULL;
+    char *endptr;
+    int option;
+    while ((option = getopt(argc, argv, "s:g:k:r:l:c:i:p:j:nt:e:o:I:")) != -1) {
+        switch (option) {
+            case 'k':
+                color_count = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || color_count < 2 || color_count > MAX_COLORS) {
+                    printUsageError();
+                }
+                break;
+            case 'I':
+                if (instanceSet(optarg) == -1) {
+                    printUsageError();
+                }
+                break;
+            case 't':
+                time_limit = strtod(optarg, &endptr);
+                if (*endptr != '\0' || !(time_limit > 0)) {
+                    printUsageError();
+                }
+                break;
+            case 'e':
+                target = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || *optarg == '\0' || target < 0 || target > INT_MAX) {
+                    printUsageError();
+                }
+                break;
+            case 'o':
+                trace_path = optarg;
+                break;
+            case 's':
+                errno = 0;
+                seed = strtoull(optarg, &endptr, 10);
+                if (*endptr != '\0' || *optarg == '\0' || errno != 0) {
+                    printUsageError();
+                }
+                break;
+            case 'g':
+                graph_path = optarg;
+                break;
+            case 'r':
+                ring_size = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || ring_size <= 0 || ring_size > RING_MAX_SIZE) {
+                    printUsageError();
+                }
+                break;
+            case 'l':
+                solution_size = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || solution_size <= 0 || solution_size > RING_MAX_SOLUTION_SIZE) {
+                    printUsageError();
+                }
+                break;
+            case 'c':
+                spin = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || spin < 0 || spin > INT_MAX) {
+                    printUsageError();
+                }
+                break;
+            case 'i':
+                interval = strtod(optarg, &endptr);
+                if (*endptr != '\0' || !(interval > 0)) {
+                    printUsageError();
+                }
+                break;
+            case 'p':
+                parts = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || parts <= 0 || parts > MAX_PARTS) {
+                    printUsageError();
+                }
+                break;
+            case 'j':
+                jobs = strtol(optarg, &endptr, 10);
+                if (*endptr != '\0' || jobs <= 0 || jobs > 1024) {
+                    printUsageError();
+                }
+                break;
+            case 'n':
+                numa = 1;
+                break;
+            default:
+                printUsageError();
+        }
+    }
+    if (optind != argc && jobs == 0) {
         printUsageError();
     }
 
-    int shmfd = shm_open(SHM, O_RDWR | O_CREAT | O_EXCL, 0600);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    FILE *trace = NULL;
+    if (trace_path != NULL) {
+        trace = fopen(trace_path, "w");
+        if (trace == NULL) {
+            fprintf(stderr, "%s: Couldn't open trace file %s.\n", program_name, trace_path);
+            exit(EXIT_FAILURE);
+        }
+        fprintf(trace, "time,edges,generator\n");
+    }
+
+    // the processors of the node come first, the supervisor keeps the first one, the
+    // generators are pinned within the processors the supervisor had before
+    int node = -1;
+    if (numa) {
+        saveAllowedCpus();
+        int cpu = pinToCpu(0);
+        node = cpu != -1 ? cpuNode(cpu) : -1;
+    }
+
+    char shm_name[INSTANCE_NAME_SIZE];
+    char graph_name[INSTANCE_NAME_SIZE];
+    char elite_name[INSTANCE_NAME_SIZE];
+    if (instanceName(shm_name, SHM) == -1 || instanceName(graph_name, SHM_GRAPH) == -1
+        || instanceName(elite_name, SHM_ELITE) == -1) {
+        fprintf(stderr, "%s: Invalid instance in %s.\n", program_name, INSTANCE_ENV);
+        exit(EXIT_FAILURE);
+    }
+
+    // the object of the ring is created first, it reserves the instance for the run
+    int shmfd = createShm(shm_name, graph_name, elite_name);
     if (shmfd == -1) {
+        fprintf(stderr, "%s: Couldn't create shared memory %s, the instance may be in use.\n",
+                program_name, shm_name);
         exit(EXIT_FAILURE);
     }
 
-    if (ftruncate(shmfd, sizeof(ShmObj)) < 0) {
+    size_t shm_size = ringObjectSize(ring_size, solution_size);
+    if (ftruncate(shmfd, shm_size) < 0) {
         close(shmfd);
-        shm_unlink(SHM);
+        shm_unlink(shm_name);
         exit(EXIT_FAILURE);
     }
 
     ShmObj *shm_obj;
-    shm_obj = mmap(NULL, sizeof(*shm_obj), PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+    shm_obj = mmap(NULL, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
 
     if (shm_obj == MAP_FAILED) {
         close(shmfd);
-        shm_unlink(SHM);
+        shm_unlink(shm_name);
         exit(EXIT_FAILURE);
     }
+    __atomic_store_n(&shm_obj->owner, getpid(), __ATOMIC_RELEASE);
 
-    shm_obj->writePos = 0;
-    shm_obj->readPos = 0;
-
-    if (close(shmfd) == -1) {
-        munmap(shm_obj, sizeof(*shm_obj));
-        shm_unlink(SHM);
+    Preprocess pre;
+    if (graph_path != NULL && loadGraph(graph_path, parts, color_count, graph_name, elite_name, &pre) == -1) {
+        close(shmfd);
+        munmap(shm_obj, shm_size);
+        shm_unlink(shm_name);
         exit(EXIT_FAILURE);
     }
 
-    sem_unlink(SEM_FREE);
-    sem_unlink(SEM_USED);
-    sem_unlink(SEM_WRITE);
-    sem_t *s_free = sem_open(SEM_FREE, O_CREAT | O_EXCL, 0600, 50);
-    if (s_free == SEM_FAILED) {
-        munmap(shm_obj, sizeof(*shm_obj));
-        shm_unlink(SHM);
-        exit(EXIT_FAILURE);
+    ringAdvise(shm_obj, shm_size);
+    shm_obj->terminate = 0;
+    shm_obj->seed = seed;
+    shm_obj->colorCount = color_count;
+    shm_obj->nextStream = 0;
+    for (int i = 0; i < STATS_SIZE; i++) {
+        shm_obj->stats[i].best = -1;
     }
-
-    sem_t *s_used = sem_open(SEM_USED, O_CREAT | O_EXCL, 0600, 0);
-    if (s_used == SEM_FAILED) {
-        munmap(shm_obj, sizeof(*shm_obj));
-        shm_unlink(SHM);
-        sem_close(s_free);
-        sem_unlink(SEM_FREE);
-        exit(EXIT_FAILURE);
+    shm_obj->bestBound = solution_size + 1;
+    shm_obj->parts = 0;
+    shm_obj->nextPart = 0;
+    if (graph_path != NULL) {
+        shm_obj->parts = pre.parts;
+        updateBounds(shm_obj, &pre, solution_size);
     }
+    ringInit(shm_obj, ring_size, solution_size, spin);
 
-    sem_t *s_write = sem_open(SEM_WRITE, O_CREAT | O_EXCL, 0600, 1);
-    if (s_write == SEM_FAILED) {
-        munmap(shm_obj, sizeof(*shm_obj));
-        shm_unlink(SHM);
-        sem_close(s_free);
-        sem_unlink(SEM_FREE);
-        sem_close(s_used);
-        sem_unlink(SEM_USED);
+    if (close(shmfd) == -1) {
+        munmap(shm_obj, shm_size);
+        shm_unlink(shm_name);
+        shm_unlink(graph_name);
+        shm_unlink(elite_name);
         exit(EXIT_FAILURE);
     }
 
@@ -143,83 +629,264 @@ int main( int argc, char *argv[] ) {
     sigaction(SIGINT, &sa, NULL);
     sigaction(SIGTERM, &sa, NULL);
 
-    int exit_code = EXIT_SUCCESS;
+    // with generators of its own the timer also wakes the supervisor to collect them,
+    // a SIGCHLD just before it sleeps is seen at the next tick
+    StatsSample first, previous;
+    uint64_t read = 0;
+    if (interval > 0 || jobs > 0) {
+        double tick = interval > 0 ? interval : 1;
+        sa.sa_handler = handle_alarm;
+        sigaction(SIGALRM, &sa, NULL);
+
+        struct itimerval timer;
+        timer.it_interval.tv_sec = (time_t) tick;
+        timer.it_interval.tv_usec = (suseconds_t) ((tick - (time_t) tick) * 1e6);
+        timer.it_value = timer.it_interval;
+        setitimer(ITIMER_REAL, &timer, NULL);
+
+        statsSample(shm_obj, read, &first);
+        previous = first;
+    }
 
-    int best_solution_length = 100000;
-    Edge best_solution[8];
-    while (!quit) {
+    // the deadline has a timer of its own, so it does not depend on the stats interval
+    timer_t deadline;
+    int deadline_armed = 0;
+    struct timespec limit_at;
+    if (time_limit > 0) {
+        sa.sa_handler = handle_deadline;
+        sigaction(SIGUSR1, &sa, NULL);
+
+        struct sigevent event;
+        memset(&event, 0, sizeof(event));
+        event.sigev_notify = SIGEV_SIGNAL;
+        event.sigev_signo = SIGUSR1;
+
+        struct itimerspec limit;
+        memset(&limit, 0, sizeof(limit));
+        limit.it_value.tv_sec = (time_t) time_limit;
+        limit.it_value.tv_nsec = (long) ((time_limit - (time_t) time_limit) * 1e9);
+
+        // the signal may arrive just before the supervisor sleeps, the sleep ends at the
+        // deadline anyway
+        limit_at.tv_sec = start.tv_sec + limit.it_value.tv_sec;
+        limit_at.tv_nsec = start.tv_nsec + limit.it_value.tv_nsec;
+        if (limit_at.tv_nsec >= 1000000000) {
+            limit_at.tv_sec++;
+            limit_at.tv_nsec -= 1000000000;
+        }
+        if (timer_create(CLOCK_MONOTONIC, &event, &deadline) == -1
+            || timer_settime(deadline, 0, &limit, NULL) == -1) {
+            fprintf(stderr, "%s: Couldn't set the time limit.\n", program_name);
+        } else {
+            deadline_armed = 1;
+        }
+    }
 
-        if (sem_wait(s_used) == -1) {
-            if (errno == EINTR) {
-                continue;
+    Ring ring = { shm_obj, spin };
+    int exit_code = EXIT_SUCCESS;
+
+    int best_solution_length = solution_size + 1;
+    int done = 0;
+    int proven_parts = 0;
+    int proven[MAX_PARTS] = { 0 };
+    int foreign = 0;
+    int lost = 0;
+    if (graph_path != NULL) {
+        if (pre.length == 0) {
+            fprintf(stdout, "The graph is %d-colorable!\n", (int) color_count);
+            done = 1;
+        } else if (pre.length <= solution_size) {
+            best_solution_length = pre.length;
+            printSolution(&pre, NULL, pre.length);
+            traceImprovement(trace, &start, pre.length, -1);
+            if (pre.length <= target) {
+                fprintf(stderr, "%s: Target of %ld edge(s) reached.\n", program_name, target);
+                done = 1;
             }
+        }
+
+        // only self loops are left, they are in every solution
+        if (!done && pre.components == 0) {
+            fprintf(stdout, "The solution with %d edge(s) is optimal!\n", pre.length);
+            done = 1;
+        }
+    }
+
+    Launcher launcher;
+    int launched = 0;
+    if (jobs > 0 && !done) {
+        sa.sa_handler = handle_child;
+        sigaction(SIGCHLD, &sa, NULL);
+
+        if (launcherInit(&launcher, argv[0], argv + optind, argc - optind, jobs, node, numa) == -1) {
+            fprintf(stderr, "%s: Couldn't start the generators.\n", program_name);
             exit_code = EXIT_FAILURE;
+            done = 1;
+        } else {
+            launched = 1;
+        }
+        for (int i = 0; launched && i < jobs; i++) {
+            if (launcherStart(&launcher, i) == -1) {
+                fprintf(stderr, "%s: Couldn't start generator %d.\n", program_name, i);
+            }
+        }
+    }
+
+    while (!quit && !done) {
+
+        if (expired) {
+            fprintf(stderr, "%s: Time limit of %g s reached.\n", program_name, time_limit);
             break;
         }
 
-        int edge_counter = 0;
-        for (int i = 0; i < 8; i++) {
-            if (!(shm_obj->data[shm_obj->readPos][i].from == -1
-               || shm_obj->data[shm_obj->readPos][i].to == -1)) {
-                edge_counter++;
+        if (children && launched) {
+            children = 0;
+            lost |= reapGenerators(&launcher, &ring, 1);
+        }
+
+        if (report) {
+            report = 0;
+            // generators the supervisor did not start are only found dead here
+            lost |= recoverStats(&ring);
+            if (interval > 0) {
+                StatsSample current;
+                statsSample(shm_obj, read, &current);
+                statsPrint(stderr, shm_obj, &previous, &current);
+                previous = current;
             }
         }
 
-        if (edge_counter == 0) {
-            fprintf(stdout, "The graph is 3-colorable!\n");
+        // a worker that died while claiming left free slots without a position or positions
+        // without a claim, they are recovered as soon as no worker claims
+        if (lost && ringRecover(&ring) == 1) {
+            lost = 0;
+        }
+
+        uint64_t pos;
+        if (ringAcquire(&ring, &pos, time_limit > 0 ? &limit_at : NULL) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == ETIMEDOUT) {
+                expired = 1;
+                continue;
+            }
+            exit_code = EXIT_FAILURE;
             break;
         }
 
-        else if (edge_counter < best_solution_length) {
-            best_solution_length = edge_counter;
-            fprintf(stdout, "Solution with %d edge(s):", edge_counter);
+        Slot *slot = ringSlot(&ring, pos);
+        int edge_counter = slot->length;
+        read++;
 
-            for (int i = 0; i < 8; i++) {
-                if (!(shm_obj->data[shm_obj->readPos][i].from == -1 ||
-                      shm_obj->data[shm_obj->readPos][i].to == -1)) {
+        if (slot->flags & SLOT_ABANDONED) {
+            ringRelease(&ring, pos);
+            continue;
+        }
 
-                    best_solution[i] = shm_obj->data[shm_obj->readPos][i];
-                    fprintf(stdout, " %d-%d", best_solution[i].from, best_solution[i].to);
+        // a generator with a graph of its own may search another graph than the one of -g,
+        // neither its solutions nor its proofs can be checked against the components
+        if (graph_path != NULL && slot->part < 0) {
+            if (!foreign) {
+                fprintf(stderr, "%s: Ignoring the solutions of generators with a graph of their own.\n",
+                        program_name);
+                foreign = 1;
+            }
+            ringRelease(&ring, pos);
+            continue;
+        }
 
-                }
+        // the proof of a part only covers its components, the graph is solved when
+        // every part is proven or one part has no solution that fits
+        if ((slot->flags & SLOT_PROVEN) && graph_path != NULL && slot->part >= 0) {
+            if (slot->part < pre.parts && !proven[slot->part]) {
+                proven[slot->part] = 1;
+                proven_parts++;
+            }
+            if (proven_parts < pre.parts
+                && (slot->part >= pre.parts || pre.partLength[slot->part] <= solution_size)) {
+                ringRelease(&ring, pos);
+                continue;
+            }
+        }
+
+        if (slot->flags & SLOT_PROVEN) {
+            if (graph_path != NULL ? pre.length > solution_size : best_solution_length > solution_size) {
+                fprintf(stdout, "No solution with at most %d edge(s) exists!\n", (int) solution_size);
+            } else {
+                fprintf(stdout, "The solution with %d edge(s) is optimal!\n", best_solution_length);
             }
+            break;
+        }
 
-            fprintf(stdout, "\n");
+        if (graph_path != NULL) {
+            if (preprocessMerge(&pre, slot->part, slot->edges, edge_counter) == 1) {
+                updateBounds(shm_obj, &pre, solution_size);
+            }
+            edge_counter = pre.length;
         }
 
+        if (edge_counter == 0) {
+            fprintf(stdout, "The graph is %d-colorable!\n", (int) color_count);
+            traceImprovement(trace, &start, 0, slot->origin);
+            break;
+        }
 
+        else if (edge_counter < best_solution_length) {
+            best_solution_length = edge_counter;
+            if (graph_path == NULL) {
+                __atomic_store_n(&shm_obj->bestBound, edge_counter, __ATOMIC_RELAXED);
+            }
+            printSolution(graph_path != NULL ? &pre : NULL, slot, edge_counter);
+            traceImprovement(trace, &start, edge_counter, slot->origin);
+            if (edge_counter <= target) {
+                fprintf(stderr, "%s: Target of %ld edge(s) reached.\n", program_name, target);
+                break;
+            }
+        }
 
-        shm_obj->readPos = (shm_obj->readPos + 1) % 50;
-        sem_post(s_free);
+        ringRelease(&ring, pos);
     }
 
-    shm_obj->terminate = 1;
+    ringShutdown(&ring);
 
-    if (sem_close(s_free) == -1) {
-        exit_code = EXIT_FAILURE;
-    }
-    if (sem_close(s_used) == -1) {
-        exit_code = EXIT_FAILURE;
+    if (deadline_armed) {
+        timer_delete(deadline);
     }
-    if (sem_close(s_write) == -1) {
-        exit_code = EXIT_FAILURE;
+
+    if (launched) {
+        launcherStop(&launcher);
+        launcherFree(&launcher);
+        recoverStats(&ring);
     }
 
-    if (sem_unlink(SEM_FREE) == -1) {
-        exit_code = EXIT_FAILURE;
+    if (interval > 0) {
+        struct itimerval stop;
+        memset(&stop, 0, sizeof(stop));
+        setitimer(ITIMER_REAL, &stop, NULL);
+
+        StatsSample last;
+        statsSample(shm_obj, read, &last);
+        statsDump(stderr, shm_obj, &first, &last);
     }
-    if (sem_unlink(SEM_USED) == -1) {
+
+    if (munmap(shm_obj, shm_size) == -1) {
         exit_code = EXIT_FAILURE;
     }
-    if (sem_unlink(SEM_WRITE) == -1) {
+
+    if (shm_unlink(shm_name) == -1) {
         exit_code = EXIT_FAILURE;
     }
 
-    if (munmap(shm_obj, sizeof(*shm_obj)) == -1) {
-        exit_code = EXIT_FAILURE;
+    if (graph_path != NULL) {
+        preprocessFree(&pre);
+        if (shm_unlink(graph_name) == -1) {
+            exit_code = EXIT_FAILURE;
+        }
+        shm_unlink(elite_name);
     }
 
-    if (shm_unlink(SHM) == -1) {
+    if (trace != NULL && fclose(trace) == EOF) {
         exit_code = EXIT_FAILURE;
     }
 
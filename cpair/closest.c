@@ -0,0 +1,455 @@
+/**
+ * @file closest.c
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief The Closest Module finds the closest pair of points inside one process. The points are sorted by x
+ * once, then every subproblem is split at its middle index, both halves are solved and the pairs across the
+ * split line are found in the strip around it. Every solved subproblem is sorted by y, so the halves are merged
+ * like in merge sort and every point of the strip is only compared to the few points above it.
+ * Large subproblems hand their left half to a pool of threads, below the cutoff a thread solves its subproblem
+ * alone.
+ *
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include "closest.h"
+
+/**
+ * distance_squared function.
+ * @brief The squared distance of two points is calculated in double precision, so no square root is needed to
+ * compare distances.
+ * @param a - first point
+ * @param b - second point
+ * @return the squared distance of these two points.
+ **/
+double distance_squared( Point a, Point b ) {
+    double dx = ( double ) a.from - b.from;
+    double dy = ( double ) a.to - b.to;
+    return dx * dx + dy * dy;
+}
+
+/**
+ * compare_points function.
+ * @brief Compares two points by their x coordinate and points with the same x by their y coordinate for qsort.
+ * @param a - pointer to the first point
+ * @param b - pointer to the second point
+ * @return negative if a comes first, positive if b comes first, 0 otherwise
+ **/
+static int compare_points( const void *a, const void *b ) {
+    const Point *first = a;
+    const Point *second = b;
+    if ( first->from != second->from ) {
+        return ( first->from > second->from ) - ( first->from < second->from );
+    }
+    return ( first->to > second->to ) - ( first->to < second->to );
+}
+
+/**
+ * swap_points function.
+ * @brief Swaps two points of an array.
+ * @param * points - the array
+ * @param i - index of the first point
+ * @param j - index of the second point
+ **/
+static void swap_points( Point *points, int i, int j ) {
+    Point point = points[ i ];
+    points[ i ] = points[ j ];
+    points[ j ] = point;
+}
+
+/**
+ * select_middle function.
+ * @brief Quickselect moves the points so that the point at index middle is the one that would be there if the array
+ * was sorted by compare_points, no point before it is larger and no point after it is smaller. Every round takes
+ * the median of three points as pivot and partitions into smaller, equal and larger points, so many equal points
+ * finish the selection early.
+ * @param * points - the points
+ * @param length - the number of points
+ * @param middle - the index to select, below length
+ **/
+void select_middle( Point *points, int length, int middle ) {
+    int low = 0;
+    int high = length - 1;
+    while ( low < high ) {
+        int center = low + ( high - low ) / 2;
+        if ( compare_points( &points[ center ], &points[ low ] ) < 0 ) {
+            swap_points( points, center, low );
+        }
+        if ( compare_points( &points[ high ], &points[ low ] ) < 0 ) {
+            swap_points( points, high, low );
+        }
+        if ( compare_points( &points[ high ], &points[ center ] ) < 0 ) {
+            swap_points( points, high, center );
+        }
+        Point pivot = points[ center ];
+
+        int smaller = low;
+        int larger = high;
+        int i = low;
+        while ( i <= larger ) {
+            int order = compare_points( &points[ i ], &pivot );
+            if ( order < 0 ) {
+                swap_points( points, smaller++, i++ );
+            } else if ( order > 0 ) {
+                swap_points( points, i, larger-- );
+            } else {
+                i++;
+            }
+        }
+
+        if ( middle < smaller ) {
+            high = smaller - 1;
+        } else if ( middle > larger ) {
+            low = larger + 1;
+        } else {
+            return;
+        }
+    }
+}
+
+/**
+ * update_pair function.
+ * @brief The two points become the closest pair if they are closer than the current one.
+ * @param * best - the current closest pair
+ * @param a - first point
+ * @param b - second point
+ **/
+static void update_pair( Pair *best, Point a, Point b ) {
+    double distance = distance_squared( a, b );
+    if ( distance < best->distance ) {
+        best->first = a;
+        best->second = b;
+        best->distance = distance;
+    }
+}
+
+/**
+ * solve_small function.
+ * @brief A subproblem of at most three points compares all pairs and is then sorted by y.
+ * @param * points - the points of the subproblem
+ * @param length - the number of points
+ * @param * best - the closest pair, only updated if a closer pair is found
+ **/
+static void solve_small( Point *points, int length, Pair *best ) {
+    for ( int i = 0; i < length; i++ ) {
+        for ( int j = i + 1; j < length; j++ ) {
+            update_pair( best, points[ i ], points[ j ] );
+        }
+    }
+
+    for ( int i = 1; i < length; i++ ) {
+        Point point = points[ i ];
+        int j = i;
+        while ( j > 0 && points[ j - 1 ].to > point.to ) {
+            points[ j ] = points[ j - 1 ];
+            j--;
+        }
+        points[ j ] = point;
+    }
+}
+
+/**
+ * combine_halves function.
+ * @brief Both solved halves are sorted by y and are merged through the buffer. Then the points closer to the
+ * split line than the closest pair are collected in the buffer. A point of this strip only has to be compared to
+ * the points above it whose y distance is smaller than the closest pair, at most seven of them.
+ * @param * points - the points of the subproblem, the halves end up merged by y
+ * @param * buffer - scratch space of length points
+ * @param length - the number of points
+ * @param middle - the number of points in the left half
+ * @param split - the x coordinate of the split line, no point of the left half lies right of it and no point of
+ * the right half left of it
+ * @param * best - the closest pair of both halves, updated with the pairs across the split line
+ **/
+void combine_halves( Point *points, Point *buffer, int length, int middle, float split, Pair *best ) {
+    int left = 0;
+    int right = middle;
+    int merged = 0;
+    while ( left < middle && right < length ) {
+        buffer[ merged++ ] = points[ left ].to <= points[ right ].to ? points[ left++ ] : points[ right++ ];
+    }
+    while ( left < middle ) {
+        buffer[ merged++ ] = points[ left++ ];
+    }
+    while ( right < length ) {
+        buffer[ merged++ ] = points[ right++ ];
+    }
+    memcpy( points, buffer, length * sizeof( Point ));
+
+    int strip = 0;
+    for ( int i = 0; i < length; i++ ) {
+        double dx = ( double ) points[ i ].from - split;
+        if ( dx * dx < best->distance ) {
+            buffer[ strip++ ] = points[ i ];
+        }
+    }
+
+    for ( int i = 0; i < strip; i++ ) {
+        for ( int j = i + 1; j < strip; j++ ) {
+            double dy = ( double ) buffer[ j ].to - buffer[ i ].to;
+            if ( dy * dy >= best->distance ) {
+                break;
+            }
+            update_pair( best, buffer[ i ], buffer[ j ] );
+        }
+    }
+}
+
+/**
+ * solve function.
+ * @brief Solves a subproblem in the calling thread.
+ * @param * points - the points of the subproblem sorted by x, they end up sorted by y
+ * @param * buffer - scratch space of length points
+ * @param length - the number of points
+ * @param * best - the closest pair, only updated if a closer pair is found
+ **/
+static void solve( Point *points, Point *buffer, int length, Pair *best ) {
+    if ( length <= 3 ) {
+        solve_small( points, length, best );
+        return;
+    }
+
+    int middle = length / 2;
+    float split = points[ middle ].from;
+
+    Pair right;
+    right.distance = DBL_MAX;
+    solve( points, buffer, middle, best );
+    solve( points + middle, buffer + middle, length - middle, &right );
+    if ( right.distance < best->distance ) {
+        *best = right;
+    }
+
+    combine_halves( points, buffer, length, middle, split, best );
+}
+
+static void solve_parallel( Pool *pool, Point *points, Point *buffer, int length, Pair *best );
+
+/**
+ * run_task function.
+ * @brief Solves a task and wakes up the thread that waits for it.
+ * @param * pool - the thread pool
+ * @param * task - the task
+ **/
+static void run_task( Pool *pool, Task *task ) {
+    solve_parallel( pool, task->points, task->buffer, task->length, &task->result );
+
+    pthread_mutex_lock( &pool->lock );
+    task->done = 1;
+    pthread_cond_broadcast( &pool->changed );
+    pthread_mutex_unlock( &pool->lock );
+}
+
+/**
+ * pool_submit function.
+ * @brief Puts a task on the stack of pending tasks.
+ * @param * pool - the thread pool
+ * @param * task - the task, it has to stay valid until pool_join returned
+ * @return integer 1 if successful, integer 0 if the stack is full
+ **/
+static int pool_submit( Pool *pool, Task *task ) {
+    pthread_mutex_lock( &pool->lock );
+    if ( pool->length == pool->capacity ) {
+        pthread_mutex_unlock( &pool->lock );
+        return 0;
+    }
+    pool->pending[ pool->length++ ] = task;
+    pthread_cond_broadcast( &pool->changed );
+    pthread_mutex_unlock( &pool->lock );
+    return 1;
+}
+
+/**
+ * pool_join function.
+ * @brief Waits until a task is done. While it waits the thread solves the newest pending tasks, which are
+ * usually its own, so a waiting thread never blocks a task another one waits for.
+ * @param * pool - the thread pool
+ * @param * task - the task
+ **/
+static void pool_join( Pool *pool, Task *task ) {
+    pthread_mutex_lock( &pool->lock );
+    while ( !task->done ) {
+        if ( pool->length > 0 ) {
+            Task *newest = pool->pending[ --pool->length ];
+            pthread_mutex_unlock( &pool->lock );
+            run_task( pool, newest );
+            pthread_mutex_lock( &pool->lock );
+        } else {
+            pthread_cond_wait( &pool->changed, &pool->lock );
+        }
+    }
+    pthread_mutex_unlock( &pool->lock );
+}
+
+/**
+ * pool_worker function.
+ * @brief Worker thread of the pool. Takes the oldest pending task, which is the largest one, until the pool stops.
+ * @param * arg - the thread pool
+ * @return NULL
+ **/
+static void *pool_worker( void *arg ) {
+    Pool *pool = arg;
+
+    pthread_mutex_lock( &pool->lock );
+    while ( 1 ) {
+        while ( !pool->stop && pool->length == 0 ) {
+            pthread_cond_wait( &pool->changed, &pool->lock );
+        }
+        if ( pool->stop ) {
+            break;
+        }
+
+        Task *oldest = pool->pending[ 0 ];
+        pool->length--;
+        memmove( pool->pending, pool->pending + 1, pool->length * sizeof( Task * ));
+        pthread_mutex_unlock( &pool->lock );
+        run_task( pool, oldest );
+        pthread_mutex_lock( &pool->lock );
+    }
+    pthread_mutex_unlock( &pool->lock );
+
+    return NULL;
+}
+
+/**
+ * solve_parallel function.
+ * @brief Solves a subproblem with the thread pool. Above the cutoff the left half is submitted as task, the
+ * calling thread solves the right half and then joins the left one.
+ * @param * pool - the thread pool
+ * @param * points - the points of the subproblem sorted by x, they end up sorted by y
+ * @param * buffer - scratch space of length points
+ * @param length - the number of points
+ * @param * best - the closest pair, only updated if a closer pair is found
+ **/
+static void solve_parallel( Pool *pool, Point *points, Point *buffer, int length, Pair *best ) {
+    if ( pool->count == 0 || length < pool->cutoff ) {
+        solve( points, buffer, length, best );
+        return;
+    }
+
+    int middle = length / 2;
+    float split = points[ middle ].from;
+
+    Task left;
+    left.points = points;
+    left.buffer = buffer;
+    left.length = middle;
+    left.result.distance = DBL_MAX;
+    left.done = 0;
+    int submitted = pool_submit( pool, &left );
+    if ( !submitted ) {
+        solve( points, buffer, middle, &left.result );
+    }
+
+    solve_parallel( pool, points + middle, buffer + middle, length - middle, best );
+
+    if ( submitted ) {
+        pool_join( pool, &left );
+    }
+    if ( left.result.distance < best->distance ) {
+        *best = left.result;
+    }
+
+    combine_halves( points, buffer, length, middle, split, best );
+}
+
+/**
+ * pool_init function.
+ * @brief Starts the worker threads. The stack holds one task for every subproblem above the cutoff.
+ * @param * pool - the thread pool
+ * @param workers - the number of worker threads
+ * @param cutoff - the number of points below which a subproblem is solved sequentially
+ * @param length - the number of points
+ * @return integer 1 if successful, integer -1 if failure
+ **/
+static int pool_init( Pool *pool, int workers, int cutoff, int length ) {
+    pthread_mutex_init( &pool->lock, NULL );
+    pthread_cond_init( &pool->changed, NULL );
+    pool->length = 0;
+    pool->capacity = 2 * ( length / cutoff + 1 );
+    pool->stop = 0;
+    pool->cutoff = cutoff;
+    pool->count = 0;
+    pool->pending = ( Task ** ) malloc( pool->capacity * sizeof( Task * ));
+    pool->threads = ( pthread_t * ) malloc(( workers + 1 ) * sizeof( pthread_t ));
+    if ( pool->pending == NULL || pool->threads == NULL ) {
+        free( pool->pending );
+        free( pool->threads );
+        return -1;
+    }
+
+    for ( int i = 0; i < workers; i++ ) {
+        if ( pthread_create( &pool->threads[ i ], NULL, pool_worker, pool ) != 0 ) {
+            break;
+        }
+        pool->count++;
+    }
+
+    return 1;
+}
+
+/**
+ * pool_destroy function.
+ * @brief Stops and joins the worker threads and frees the pool.
+ * @param * pool - the thread pool
+ **/
+static void pool_destroy( Pool *pool ) {
+    pthread_mutex_lock( &pool->lock );
+    pool->stop = 1;
+    pthread_cond_broadcast( &pool->changed );
+    pthread_mutex_unlock( &pool->lock );
+
+    for ( int i = 0; i < pool->count; i++ ) {
+        pthread_join( pool->threads[ i ], NULL );
+    }
+
+    free( pool->pending );
+    free( pool->threads );
+    pthread_cond_destroy( &pool->changed );
+    pthread_mutex_destroy( &pool->lock );
+}
+
+/**
+ * closest_pair function.
+ * @brief Finds the closest pair of the points. The points are sorted by x once and solved with the thread pool,
+ * afterwards they are sorted by y. The first point of the pair is the smaller one by x and then y.
+ * @param * point_array - the points, they are reordered
+ * @param threads - the number of threads including the calling one
+ * @param cutoff - the number of points below which a subproblem is solved sequentially
+ * @param * result - the closest pair, its distance stays DBL_MAX with less than two points
+ * @return integer 1 if successful, integer -1 if failure
+ **/
+int closest_pair( PointArray *point_array, int threads, int cutoff, Pair *result ) {
+    result->distance = DBL_MAX;
+    if ( point_array->length < 2 ) {
+        return 1;
+    }
+
+    Point *buffer = ( Point * ) malloc( point_array->length * sizeof( Point ));
+    if ( buffer == NULL ) {
+        return -1;
+    }
+
+    Pool pool;
+    if ( pool_init( &pool, threads - 1, cutoff, point_array->length ) == -1 ) {
+        free( buffer );
+        return -1;
+    }
+
+    qsort( point_array->content, point_array->length, sizeof( Point ), compare_points );
+    solve_parallel( &pool, point_array->content, buffer, point_array->length, result );
+
+    pool_destroy( &pool );
+    free( buffer );
+
+    if ( compare_points( &result->second, &result->first ) < 0 ) {
+        Point first = result->first;
+        result->first = result->second;
+        result->second = first;
+    }
+
+    return 1;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file closest.h
+ * @author Maximilian Hagn <11808237@student.tuwien.ac.at>
+ * @date 17.10.2026
+ *
+ * @brief Contains structs for closest.c
+ *
+ **/
+
+#ifndef CLOSEST_H
+#define CLOSEST_H
+
+#include <pthread.h>
+
+#include "cpair.h"
+
+/**
+ * default number of points below which a subproblem is solved by the thread that created it
+ **/
+#define DEFAULT_CUTOFF 8192
+
+// Defines one half of a subproblem that is handed to the thread pool
+// points and buffer are the points of the half and the scratch space of the same length,
+// result is the closest pair of the half, done is set when the half is solved
+struct Task {
+    Point *points;
+    Point *buffer;
+    int length;
+    Pair result;
+    int done;
+};
+typedef struct Task Task;
+
+// Defines the thread pool of the engine
+// pending is a stack of the submitted tasks that no thread has taken yet, changed is
+// signalled whenever a task is submitted or done, stop ends the workers
+// cutoff is the number of points below which a subproblem is solved sequentially
+struct Pool {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    Task **pending;
+    int length;
+    int capacity;
+    int stop;
+    int cutoff;
+    pthread_t *threads;
+    int count;
+};
+typedef struct Pool Pool;
+
+double distance_squared( Point a, Point b );
+void select_middle( Point *points, int length, int middle );
+void combine_halves( Point *points, Point *buffer, int length, int middle, float split, Pair *best );
+int closest_pair( PointArray *point_array, int threads, int cutoff, Pair *result );
+
+#endif
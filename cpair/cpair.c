@@ -5,8 +5,12 @@
  *
  * @brief The Cpair Module reads 2D Points from Stdin. If one Point is read, the program exit without output.
  * If two points are read, the program writes these two points to stdout. If more than two points are read the
- * program forks and passes each half to one of two child processes. The result is than compared and the two points
- * with the smallest distance are marked as closest pair.
+ * closest pair is found by the threaded engine of the closest module and written to stdout.
+ * With the option -p the program forks instead and passes each half to one of two child processes. The result is
+ * than compared and the two points with the smallest distance are marked as closest pair. The children are started
+ * with the additional option -w, a worker reads and writes binary frames instead of text: an int with the number of
+ * points followed by the raw points. The reply of a worker holds the closest pair followed by all its points sorted
+ * by y. Only the outermost process reads and writes text.
  *
  **/
 
@@ -18,7 +22,10 @@
 #include <math.h>
 #include <sys/types.h>
 #include <float.h>
+#include <limits.h>
+#include <errno.h>
 #include "cpair.h"
+#include "closest.h"
 
 /**
  * Pointer to name of program
@@ -31,30 +38,166 @@ static char *program_name;
  * @details global variables: program_name, contains the name of the program
  **/
 static void usage( void ) {
-    fprintf( stderr, "Usage: %s\n", program_name );
+    fprintf( stderr, "Usage: %s [-t THREADS] [-c CUTOFF] [-p]\n", program_name );
     exit( EXIT_FAILURE );
 }
 
 /**
- * calc_distance function.
- * @brief The distance of two points is calculated and returned as a float value.
- * @param a - first point
- * @param b - second point
- * @return the distance of these two points in float.
+ * write_points function.
+ * @brief The points are written line by line to the given file.
+ * @param * output - the file which is written to.
+ * @param * points - the points.
+ * @param length - the number of points.
+ * @return integer 1 if successful, integer -1 if failure
+ **/
+static int write_points( FILE *output, Point *points, int length ) {
+    for ( int i = 0; i < length; i++ ) {
+        if ( fprintf( output, "%f %f\n", points[ i ].from, points[ i ].to ) < 0 ) {
+            return -1;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * read_all function.
+ * @brief Reads exactly the given number of bytes from a file descriptor, short reads are continued.
+ * @param fd - the file descriptor which is read from.
+ * @param * data - the space for the bytes.
+ * @param size - the number of bytes.
+ * @return integer 1 if successful, integer -1 if failure or if the input ends before
+ **/
+static int read_all( int fd, void *data, size_t size ) {
+    char *position = data;
+    while ( size > 0 ) {
+        ssize_t count = read( fd, position, size );
+        if ( count == -1 && errno == EINTR ) {
+            continue;
+        }
+        if ( count <= 0 ) {
+            return -1;
+        }
+        position += count;
+        size -= count;
+    }
+
+    return 1;
+}
+
+/**
+ * write_all function.
+ * @brief Writes exactly the given number of bytes to a file descriptor, short writes are continued.
+ * @param fd - the file descriptor which is written to.
+ * @param * data - the bytes.
+ * @param size - the number of bytes.
+ * @return integer 1 if successful, integer -1 if failure
+ **/
+static int write_all( int fd, const void *data, size_t size ) {
+    const char *position = data;
+    while ( size > 0 ) {
+        ssize_t count = write( fd, position, size );
+        if ( count == -1 && errno == EINTR ) {
+            continue;
+        }
+        if ( count == -1 ) {
+            return -1;
+        }
+        position += count;
+        size -= count;
+    }
+
+    return 1;
+}
+
+/**
+ * read_frame function.
+ * @brief A binary frame is read from another cpair process: an int with the number of points followed by the raw
+ * points. The given PointArray is resized to hold them.
+ * @param fd - the file descriptor which is read from.
+ * @param * result - the pointer to the result array.
+ * @return integer 1 if successful, integer -1 if failure
+ **/
+static int read_frame( int fd, PointArray *result ) {
+    int length;
+    if ( read_all( fd, &length, sizeof( length )) == -1 || length < 0 ) {
+        return -1;
+    }
+
+    Point *new_data = realloc( result->content, ( length > 0 ? length : 1 ) * sizeof( Point ));
+    if ( new_data == NULL ) {
+        return -1;
+    }
+    result->content = new_data;
+
+    if ( read_all( fd, result->content, ( size_t ) length * sizeof( Point )) == -1 ) {
+        return -1;
+    }
+
+    result->length = length;
+    return 1;
+}
+
+/**
+ * write_frame function.
+ * @brief A binary frame is written to another cpair process. The header and the pair go out in one write, the
+ * points in another one.
+ * @param fd - the file descriptor which is written to.
+ * @param * pair - the two points of the closest pair written before the points, NULL for none.
+ * @param * points - the points.
+ * @param length - the number of points.
+ * @return integer 1 if successful, integer -1 if failure
  **/
-static float calc_distance( Point a, Point b ) {
-    float result = sqrt(( a.from - b.from ) *
-                        ( a.from - b.from ) +
-                        ( a.to - b.to ) *
-                        ( a.to - b.to ));
+static int write_frame( int fd, const Point *pair, const Point *points, int length ) {
+    char head[sizeof( int ) + 2 * sizeof( Point )];
+    int pair_length = pair != NULL ? 2 : 0;
+    int frame_length = length + pair_length;
+
+    memcpy( head, &frame_length, sizeof( int ));
+    if ( pair != NULL ) {
+        memcpy( head + sizeof( int ), pair, 2 * sizeof( Point ));
+    }
 
-    return result;
+    if ( write_all( fd, head, sizeof( int ) + pair_length * sizeof( Point )) == -1 ) {
+        return -1;
+    }
+
+    return write_all( fd, points, ( size_t ) length * sizeof( Point ));
+}
+
+/**
+ * child_points function.
+ * @brief A child with at least two points replies with its closest pair followed by all its points sorted by y,
+ * a child with less points only with its points. The pair of the child becomes the closest pair if it is closer.
+ * @param * reply - the frame read from the child.
+ * @param length - the number of points the child was given.
+ * @param * best - the closest pair, only updated if the pair of the child is closer.
+ * @return pointer to the points of the child sorted by y, NULL if the reply has the wrong number of points
+ **/
+static Point *child_points( PointArray *reply, int length, Pair *best ) {
+    if ( length < 2 ) {
+        return reply->length == length ? reply->content : NULL;
+    }
+
+    if ( reply->length != length + 2 ) {
+        return NULL;
+    }
+
+    double distance = distance_squared(( reply->content )[ 0 ], ( reply->content )[ 1 ] );
+    if ( distance < best->distance ) {
+        best->first = ( reply->content )[ 0 ];
+        best->second = ( reply->content )[ 1 ];
+        best->distance = distance;
+    }
+
+    return reply->content + 2;
 }
 
 /**
  * read_input function.
  * @brief The input is read from a specified file and written to the given PointArray.
  * The input is written line by line und the points are than extracted and casted to float values.
+ * The array doubles its size whenever it is full, it has to hold space for one point at the start.
  * @param * input - the file which is read from.
  * @param * result - the pointer to the result array.
  * @return integer 1 if successful, integer -1 if failure
@@ -94,14 +237,16 @@ static int read_input( FILE *input, PointArray *result ) {
 
         free( active_point );
 
-        Point *new_data = realloc( result->content, (( result->length ) + 1 ) * sizeof( Point ));
-        if ( new_data == NULL ) {
-            free( line );
-            return -1;
+        if ( result->length > 0 && ( result->length & ( result->length - 1 )) == 0 ) {
+            Point *new_data = realloc( result->content, 2 * ( result->length ) * sizeof( Point ));
+            if ( new_data == NULL ) {
+                free( line );
+                return -1;
+            }
+            result->content = new_data;
         }
 
         result->length = ( result->length ) + 1;
-        result->content = new_data;
         ( result->content )[ ( result->length ) - 1 ].from = from;
         ( result->content )[ ( result->length ) - 1 ].to = to;
     }
@@ -112,66 +257,27 @@ static int read_input( FILE *input, PointArray *result ) {
 
 /**
  * fork_array function.
- * @brief If the input is greater than 2 the program is forked. This functionality is handeled by the
- * fork_array function. First the array is split into to halfs. Each half is redirected to one child process.
- * Furthermore, the results from the child function are compared and the smaller one is taken as result. Then all points
- * from the first child are compared to the other childs points. The smallest point is than redirected to the parent.
- * @param * point_array - a pointer to all read points.
+ * @brief If the input is greater than 2 and the option -p is given the program is forked. This functionality is
+ * handeled by the fork_array function. The children run the same binary again with -p -w. First the array is split
+ * into to halfs of equal size at the median by x and then y, so equal x values never end up in one child forever.
+ * Each half is redirected to one child process.
+ * The halves are passed as binary frames, every child replies with its closest pair and its points sorted by y. The closer pair of both children is taken
+ * as result, then the sorted points are merged and only the points in the strip around the split line are compared.
+ * The closest pair is than redirected to the parent, a worker also passes on all points sorted by y.
+ * @param * point_array - a pointer to all read points, the space is reused for the merged points.
+ * @param worker - 1 if the parent is a cpair process itself, 0 otherwise
  * @return integer 1 if successful, integer -1 if failure
  **/
-static int fork_array( PointArray *point_array ) {
+static int fork_array( PointArray *point_array, int worker ) {
 
-    PointArray *smaller_than_arithmetic = ( PointArray * ) malloc( sizeof( PointArray ));
-    smaller_than_arithmetic->length = 0;
-    smaller_than_arithmetic->content = ( Point * ) malloc( sizeof( Point ));
+    char *process_argv[] = { program_name, "-p", "-w", NULL };
 
-    PointArray *larger_than_arithmetic = ( PointArray * ) malloc( sizeof( PointArray ));
-    larger_than_arithmetic->length = 0;
-    larger_than_arithmetic->content = ( Point * ) malloc( sizeof( Point ));
+    int middle = point_array->length / 2;
+    select_middle( point_array->content, point_array->length, middle );
+    float median = ( point_array->content )[ middle ].from;
 
-    float sum = 0;
-    float arithmetic = 0;
-
-    for ( int i = 0; i < point_array->length; i++ ) {
-        sum = sum + ( point_array->content )[ i ].from;
-    }
-
-    arithmetic = sum * ( 1 / ( float ) point_array->length );
-
-    for ( int i = 0; i < point_array->length; i++ ) {
-        if (( point_array->content )[ i ].from <= arithmetic ) {
-
-            Point *new_data = realloc( smaller_than_arithmetic->content,
-                                       (( smaller_than_arithmetic->length ) + 1 ) * sizeof( Point ));
-            if ( new_data == NULL ) {
-                return -1;
-            }
-
-            smaller_than_arithmetic->length = ( smaller_than_arithmetic->length ) + 1;
-            smaller_than_arithmetic->content = new_data;
-            ( smaller_than_arithmetic->content )[ ( smaller_than_arithmetic->length ) -
-                                                  1 ].from = ( point_array->content )[ i ].from;
-            ( smaller_than_arithmetic->content )[ ( smaller_than_arithmetic->length ) -
-                                                  1 ].to = ( point_array->content )[ i ].to;
-
-        } else {
-
-            Point *new_data = realloc( larger_than_arithmetic->content,
-                                       (( larger_than_arithmetic->length ) + 1 ) * sizeof( Point ));
-            if ( new_data == NULL ) {
-                return -1;
-            }
-
-            larger_than_arithmetic->length = ( larger_than_arithmetic->length ) + 1;
-            larger_than_arithmetic->content = new_data;
-            ( larger_than_arithmetic->content )[ ( larger_than_arithmetic->length ) -
-                                                 1 ].from = ( point_array->content )[ i ].from;
-            ( larger_than_arithmetic->content )[ ( larger_than_arithmetic->length ) -
-                                                 1 ].to = ( point_array->content )[ i ].to;
-
-
-        }
-    }
+    PointArray smaller_than_median = { middle, point_array->content };
+    PointArray larger_than_median = { point_array->length - middle, point_array->content + middle };
 
 
     int pipe_p_to_c1[2];
@@ -213,7 +319,7 @@ static int fork_array( PointArray *point_array ) {
             return -1;
         }
 
-        execlp( "./cpair", "cpair", NULL );
+        execvp( program_name, process_argv );
         return -1;
 
     }
@@ -265,7 +371,7 @@ static int fork_array( PointArray *point_array ) {
             return -1;
         }
 
-        execlp( "./cpair", "cpair", NULL );
+        execvp( program_name, process_argv );
         return -1;
 
     }
@@ -279,64 +385,20 @@ static int fork_array( PointArray *point_array ) {
     }
 
 
-    FILE *file_p_to_c1 = fdopen( pipe_p_to_c1[ 1 ], "w" );
-    if ( file_p_to_c1 != NULL ) {
-
-        for ( int i = 0; i < smaller_than_arithmetic->length; i++ ) {
-            if ( fprintf( file_p_to_c1, "%f %f\n", ( smaller_than_arithmetic->content )[ i ].from,
-                          ( smaller_than_arithmetic->content )[ i ].to ) < 0 ) {
-                return -1;
-            }
-        }
-
-        if ( fflush( file_p_to_c1 ) == EOF ) {
-            return -1;
-        }
-
-
-        if ( fclose( file_p_to_c1 ) == EOF ) {
-            return -1;
-        }
-
-    } else {
+    if ( write_frame( pipe_p_to_c1[ 1 ], NULL, smaller_than_median.content, smaller_than_median.length ) == -1
+         || close( pipe_p_to_c1[ 1 ] ) == -1 ) {
         return -1;
     }
 
-    FILE *file_p_to_c2 = fdopen( pipe_p_to_c2[ 1 ], "w" );
-    if ( file_p_to_c2 != NULL ) {
-
-        for ( int i = 0; i < larger_than_arithmetic->length; i++ ) {
-            if ( fprintf( file_p_to_c2, "%f %f\n", ( larger_than_arithmetic->content )[ i ].from,
-                          ( larger_than_arithmetic->content )[ i ].to ) < 0 ) {
-                return -1;
-            }
-        }
-
-        if ( fflush( file_p_to_c2 ) == EOF )
-            return -1;
-
-        if ( fclose( file_p_to_c2 ) == EOF )
-            return -1;
-
-    } else {
-        return -1;
-    }
-
-    int status[2];
-    int c1_error_code = waitpid( c1_id, &status[ 0 ], 0 );
-    int c2_error_code = waitpid( c2_id, &status[ 1 ], 0 );
-    if ( WEXITSTATUS( status[ 0 ] ) != EXIT_SUCCESS
-         || WEXITSTATUS( status[ 1 ] ) != EXIT_SUCCESS
-         || c1_error_code < 0
-         || c2_error_code < 0 ) {
+    if ( write_frame( pipe_p_to_c2[ 1 ], NULL, larger_than_median.content, larger_than_median.length ) == -1
+         || close( pipe_p_to_c2[ 1 ] ) == -1 ) {
         return -1;
     }
 
     PointArray *c1_result = ( PointArray * ) malloc( sizeof( PointArray ));
     c1_result->length = 0;
     c1_result->content = ( Point * ) malloc( sizeof( Point ));
-    FILE *c1_result_file = fdopen( pipe_c1_to_p[ 0 ], "r" );
-    if ( read_input( c1_result_file, c1_result ) == -1 ) {
+    if ( read_frame( pipe_c1_to_p[ 0 ], c1_result ) == -1 ) {
         free( c1_result->content );
         free( c1_result );
         exit( EXIT_FAILURE );
@@ -346,61 +408,56 @@ static int fork_array( PointArray *point_array ) {
     PointArray *c2_result = ( PointArray * ) malloc( sizeof( PointArray ));
     c2_result->length = 0;
     c2_result->content = ( Point * ) malloc( sizeof( Point ));
-    FILE *c2_result_file = fdopen( pipe_c2_to_p[ 0 ], "r" );
-    if ( read_input( c2_result_file, c2_result ) == -1 ) {
+    if ( read_frame( pipe_c2_to_p[ 0 ], c2_result ) == -1 ) {
         free( c2_result->content );
         free( c2_result );
         exit( EXIT_FAILURE );
     }
 
+    close( pipe_c1_to_p[ 0 ] );
+    close( pipe_c2_to_p[ 0 ] );
 
-    float distance_c1 = calc_distance(( c1_result->content )[ 0 ], ( c1_result->content )[ 1 ] );
-    float distance_c2 = calc_distance(( c2_result->content )[ 0 ], ( c2_result->content )[ 1 ] );
-
-    float min = FLT_MAX;
-    Point result_points[2];
-
-    if ( c1_result->length == 2 ) {
-        min = distance_c1;
-        result_points[ 0 ].from = ( c1_result->content )[ 0 ].from;
-        result_points[ 0 ].to = ( c1_result->content )[ 0 ].to;
-        result_points[ 1 ].from = ( c1_result->content )[ 1 ].from;
-        result_points[ 1 ].to = ( c1_result->content )[ 1 ].to;
+    int status[2];
+    int c1_error_code = waitpid( c1_id, &status[ 0 ], 0 );
+    int c2_error_code = waitpid( c2_id, &status[ 1 ], 0 );
+    if ( WEXITSTATUS( status[ 0 ] ) != EXIT_SUCCESS
+         || WEXITSTATUS( status[ 1 ] ) != EXIT_SUCCESS
+         || c1_error_code < 0
+         || c2_error_code < 0 ) {
+        return -1;
     }
 
+    int c1_length = smaller_than_median.length;
+    int c2_length = larger_than_median.length;
 
-    if ( distance_c2 < min ) {
-        if ( c2_result->length == 2 ) {
-            min = distance_c2;
-            result_points[ 0 ].from = ( c2_result->content )[ 0 ].from;
-            result_points[ 0 ].to = ( c2_result->content )[ 0 ].to;
-            result_points[ 1 ].from = ( c2_result->content )[ 1 ].from;
-            result_points[ 1 ].to = ( c2_result->content )[ 1 ].to;
-        }
+    Pair result;
+    result.distance = DBL_MAX;
+    Point *c1_points = child_points( c1_result, c1_length, &result );
+    Point *c2_points = child_points( c2_result, c2_length, &result );
+    Point *buffer = ( Point * ) malloc( point_array->length * sizeof( Point ));
+    if ( c1_points == NULL || c2_points == NULL || buffer == NULL ) {
+        return -1;
     }
 
-    for ( int i = 0; i < c1_result->length; i++ ) {
-        for ( int j = 0; j < c2_result->length; j++ ) {
-            float distance = calc_distance(( c1_result->content )[ i ], ( c2_result->content )[ j ] );
-            if ( distance < min ) {
-                min = distance;
-                result_points[ 0 ].from = ( c1_result->content )[ i ].from;
-                result_points[ 0 ].to = ( c1_result->content )[ i ].to;
-                result_points[ 1 ].from = ( c2_result->content )[ j ].from;
-                result_points[ 1 ].to = ( c2_result->content )[ j ].to;
-            }
-        }
-    }
+    memcpy( point_array->content, c1_points, c1_length * sizeof( Point ));
+    memcpy( point_array->content + c1_length, c2_points, c2_length * sizeof( Point ));
+    combine_halves( point_array->content, buffer, point_array->length, c1_length, median, &result );
 
+    free( buffer );
     free( c1_result->content );
     free( c1_result );
     free( c2_result->content );
     free( c2_result );
-    fclose( c1_result_file );
-    fclose( c2_result_file );
 
-    fprintf( stdout, "%f %f\n", result_points[ 0 ].from, result_points[ 0 ].to );
-    fprintf( stdout, "%f %f\n", result_points[ 1 ].from, result_points[ 1 ].to );
+    if ( worker ) {
+        Point pair[2] = { result.first, result.second };
+        if ( write_frame( STDOUT_FILENO, pair, point_array->content, point_array->length ) == -1 ) {
+            return -1;
+        }
+    } else {
+        fprintf( stdout, "%f %f\n", result.first.from, result.first.to );
+        fprintf( stdout, "%f %f\n", result.second.from, result.second.to );
+    }
 
 
     if ( fflush( stdout ) == EOF ) {
@@ -416,9 +473,9 @@ static int fork_array( PointArray *point_array ) {
 
 /**
  * Program entry point.
- * @brief The program starts here. This function creates the storage for all read points. After
- * reading the input, the function decides if the program exits, if the the input is written to stdout
- * or if the program is forked.
+ * @brief The program starts here. This function parses the options and creates the storage for all read points.
+ * After reading the input, the function decides if the program exits, if the the input is written to stdout,
+ * if the closest pair is found by the threaded engine or if the program is forked.
  * @param argc The argument counter.
  * @param argv The argument vector.
  * @return Returns EXIT_SUCCESS or EXIT_FAILURE
@@ -427,42 +484,99 @@ int main( int argc, char **argv ) {
 
     program_name = argv[ 0 ];
 
-    if ( argc > 1 ) {
+    long threads = sysconf( _SC_NPROCESSORS_ONLN );
+    long cutoff = DEFAULT_CUTOFF;
+    int processes = 0;
+    int worker = 0;
+    char *endptr = NULL;
+    int c;
+    while (( c = getopt( argc, argv, "t:c:pw" )) != -1 ) {
+        switch ( c ) {
+            case 't':
+                threads = strtol( optarg, &endptr, 10 );
+                if ( *endptr != '\0' || threads < 1 || threads > 1024 ) {
+                    usage( );
+                }
+                break;
+            case 'c':
+                cutoff = strtol( optarg, &endptr, 10 );
+                if ( *endptr != '\0' || cutoff < 4 || cutoff > INT_MAX ) {
+                    usage( );
+                }
+                break;
+            case 'p':
+                processes = 1;
+                break;
+            case 'w':
+                processes = 1;
+                worker = 1;
+                break;
+            default:
+                usage( );
+        }
+    }
+
+    if ( optind < argc ) {
         usage( );
     }
 
+    if ( threads < 1 ) {
+        threads = 1;
+    }
+
     PointArray *point_array = ( PointArray * ) malloc( sizeof( PointArray ));
     point_array->length = 0;
     point_array->content = ( Point * ) malloc( sizeof( Point ));
 
-    if ( read_input( stdin, point_array ) == -1 ) {
+    int loaded = worker ? read_frame( STDIN_FILENO, point_array ) : read_input( stdin, point_array );
+    if ( loaded == -1 ) {
         free( point_array->content );
         free( point_array );
         exit( EXIT_FAILURE );
     }
 
     if ( point_array->length <= 1 ) {
+        int written = worker ? write_frame( STDOUT_FILENO, NULL, point_array->content, point_array->length ) : 1;
+
         free( point_array->content );
         free( point_array );
-        exit( EXIT_SUCCESS );
+        exit( written == -1 ? EXIT_FAILURE : EXIT_SUCCESS );
     }
 
     if ( point_array->length == 2 ) {
-        for ( int i = 0; i < 2; i++ ) {
-            fprintf( stdout, "%f %f\n", ( point_array->content )[ i ].from, ( point_array->content )[ i ].to );
+        int written = 1;
+        if ( worker ) {
+            Point pair[2] = {( point_array->content )[ 0 ], ( point_array->content )[ 1 ] };
+            if (( point_array->content )[ 0 ].to > ( point_array->content )[ 1 ].to ) {
+                ( point_array->content )[ 0 ] = pair[ 1 ];
+                ( point_array->content )[ 1 ] = pair[ 0 ];
+            }
+            written = write_frame( STDOUT_FILENO, pair, point_array->content, 2 );
+        } else {
+            written = write_points( stdout, point_array->content, 2 );
         }
 
         free( point_array->content );
         free( point_array );
-        exit( EXIT_SUCCESS );
+        exit( written == -1 ? EXIT_FAILURE : EXIT_SUCCESS );
     }
 
-    if ( point_array->length > 2 ) {
-        if ( fork_array( point_array ) == -1 ) {
+    if ( point_array->length > 2 && processes ) {
+        if ( fork_array( point_array, worker ) == -1 ) {
             free( point_array->content );
             free( point_array );
             exit( EXIT_FAILURE );
         }
+    } else if ( point_array->length > 2 ) {
+        Pair result;
+        if ( closest_pair( point_array, threads, cutoff, &result ) == -1 ) {
+            free( point_array->content );
+            free( point_array );
+            exit( EXIT_FAILURE );
+        }
+
+        fprintf( stdout, "%f %f\n", result.first.from, result.first.to );
+        fprintf( stdout, "%f %f\n", result.second.from, result.second.to );
     }
 
     free( point_array->content );
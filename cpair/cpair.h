@@ -24,6 +24,15 @@ struct PointArray {
 };
 typedef struct PointArray PointArray;
 
+// Defines the closest pair of a set of points, first and second are the two points and
+// distance is their squared distance, DBL_MAX as long as no pair was found
+struct Pair {
+    Point first;
+    Point second;
+    double distance;
+};
+typedef struct Pair Pair;
+
 
 
 #endif